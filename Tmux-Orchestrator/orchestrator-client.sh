@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# 제어 데몬 클라이언트 (다른 스크립트에서 source 하여 사용)
+# orch_call <command> [args...]
+#   데몬(orchestrator-daemon.mjs)이 떠 있으면 Unix 소켓 왕복 한 번으로 처리
+#   떠 있지 않으면 한 번 띄워 보고 (ORCH_AUTOSTART=0 이면 생략)
+#   그래도 안 되면 기존처럼 osascript 로 직접 실행 (Terminal.app 백엔드만 가능)
+
+ORCH_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+_orch_tmp="${TMPDIR:-/tmp}"
+ORCH_SOCKET="${ORCH_SOCKET:-${_orch_tmp%/}/terminal-orchestrator-$(id -u)/daemon.sock}"
+export ORCH_SOCKET
+if [ -z "$ORCH_BACKEND" ]; then
+    if [ "$(uname)" = "Darwin" ]; then ORCH_BACKEND="terminal"; else ORCH_BACKEND="tmux"; fi
+fi
+export ORCH_BACKEND
+
+# 표준 입력의 요청을 소켓으로 보내고 응답을 출력 (nc → python3 → node 순)
+orch_transport() {
+    if command -v nc >/dev/null 2>&1; then
+        nc -U "$ORCH_SOCKET" 2>/dev/null
+    elif command -v python3 >/dev/null 2>&1; then
+        python3 -c '
+import socket, sys
+s = socket.socket(socket.AF_UNIX)
+s.connect(sys.argv[1])
+s.sendall(sys.stdin.buffer.read())
+while True:
+    data = s.recv(65536)
+    if not data:
+        break
+    sys.stdout.buffer.write(data)
+' "$ORCH_SOCKET" 2>/dev/null
+    else
+        node "$ORCH_DIR/orchestrator-daemon.mjs" pipe 2>/dev/null
+    fi
+}
+
+orch_start_daemon() {
+    [ "${ORCH_AUTOSTART:-1}" = "0" ] && return 1
+    command -v node >/dev/null 2>&1 || return 1
+    node "$ORCH_DIR/orchestrator-daemon.mjs" start >/dev/null 2>&1
+}
+
+# 응답 첫 줄(종료 코드)은 호출한 함수의 status 변수에, 본문은 표준 출력으로
+orch_request() {
+    { IFS= read -r status; cat; } < <(printf '%s\0' "$#" "$@" | orch_transport)
+}
+
+orch_call() {
+    local status=""
+    # 본인 소유의 소켓에만 요청을 보냄 (다른 사용자가 심어 둔 소켓 무시)
+    [ -S "$ORCH_SOCKET" ] && [ -O "$ORCH_SOCKET" ] && orch_request "$@"
+    # 소켓이 없거나 남아 있던 소켓이 응답하지 않으면 데몬을 띄우고 한 번 더
+    if [ -z "$status" ] && orch_start_daemon; then
+        orch_request "$@"
+    fi
+    if [ -n "$status" ]; then
+        return "$status"
+    fi
+
+    # 데몬을 쓸 수 없음: 명령마다 osascript 실행
+    if [ "$ORCH_BACKEND" != "terminal" ]; then
+        echo "❌ 제어 데몬을 시작할 수 없습니다 ($ORCH_BACKEND 백엔드는 Node.js 데몬이 필요합니다)"
+        return 1
+    fi
+    osascript "$ORCH_DIR/terminal-control.applescript" "$@"
+}
@@ -0,0 +1,437 @@
+#!/usr/bin/env node
+// 터미널 오케스트레이터 제어 데몬
+// 명령마다 osascript 를 새로 띄우는 대신, 한 번 띄운 백엔드(스크립팅 브리지)와 세션 핸들을
+// 메모리에 유지하고 로컬 Unix 소켓으로 요청을 받는다. 셸 스크립트는 orchestrator-client.sh 로 연결한다.
+// 백엔드: macOS 는 Terminal.app(terminal), 그 밖에는 tmux (ORCH_BACKEND 로 지정 가능)
+//
+// 요청: 인자 개수와 각 인자를 NUL 로 끝맺어 보냄   printf '%s\0' "$#" "$@"
+// 응답: 첫 줄에 종료 코드(0 성공), 이어서 출력 본문. 응답 후 연결을 닫는다.
+//
+// 사용법: node orchestrator-daemon.mjs run|start|stop|status|pipe
+
+import net from 'net';
+import { spawn } from 'child_process';
+import { lstatSync, mkdirSync, openSync, statSync, unlinkSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { fileURLToPath } from 'url';
+import { TerminalBackend } from './terminal-backend.mjs';
+import { TmuxBackend } from './tmux-backend.mjs';
+import { RingBuffer } from './ring-buffer.mjs';
+import { HANDLE_GONE, SessionRegistry } from './session-registry.mjs';
+
+// 소켓과 로그는 사용자 전용(0700) 디렉터리에 둔다. 공유 /tmp 에서 다른 사용자가 소켓에 접속해
+// 탭에 키 입력을 보내거나, 미리 가짜 소켓·로그 링크를 만들어 두지 못하도록.
+export const RUNTIME_DIR = join(tmpdir(), `terminal-orchestrator-${process.getuid()}`);
+export const SOCKET_PATH = process.env.ORCH_SOCKET || join(RUNTIME_DIR, 'daemon.sock');
+const LOG_PATH = process.env.ORCH_LOG || join(RUNTIME_DIR, 'daemon.log');
+const START_TIMEOUT_MS = 3000;
+const SCROLLBACK_BYTES = Number(process.env.ORCH_SCROLLBACK_BYTES) || 1024 * 1024;
+// 입력 대기 판단: 출력 끝부분의 마지막 몇 줄이 프롬프트 패턴과 맞거나, 출력이 IDLE_MS 동안 멈춤 (0 이면 패턴만 사용)
+const READY_PATTERN = new RegExp(process.env.ORCH_READY_PATTERN || '[$#%>❯]\\s*$|│\\s*>\\s');
+const READY_TIMEOUT_MS = Number(process.env.ORCH_READY_TIMEOUT_MS) || 5000;
+const IDLE_MS = Number(process.env.ORCH_IDLE_MS ?? 1000);
+const READY_LINES = 8;
+const READY_TAIL_BYTES = 512;
+// 출력을 밀어 주지 않는 백엔드(Terminal)의 폴링 간격: 새 출력이 없으면 두 배씩 늘림
+const POLL_MS = 50;
+const MAX_POLL_MS = 400;
+const SETTLE_MS = 50;
+
+// 없으면 0700 으로 만들고, 이미 있으면 내 소유이며 다른 사용자가 접근할 수 없는 디렉터리인지 확인
+function ensurePrivateDir(dir) {
+  mkdirSync(dir, { recursive: true, mode: 0o700 });
+  const info = lstatSync(dir);
+  if (!info.isDirectory() || info.uid !== process.getuid() || (info.mode & 0o077) !== 0) {
+    throw new Error(`안전하지 않은 디렉터리입니다 (본인 소유의 0700 디렉터리여야 함): ${dir}`);
+  }
+}
+
+export function encodeRequest(args) {
+  return Buffer.from([String(args.length), ...args].map(arg => `${arg}\0`).join(''));
+}
+
+// 완성된 요청이면 인자 배열, 아직 덜 받았으면 null
+export function decodeRequest(buffer) {
+  const fields = buffer.toString('utf8').split('\0');
+  const count = Number(fields[0]);
+  if (fields.length < 2 || !Number.isInteger(count) || fields.length < count + 2) return null;
+  return fields.slice(1, count + 1);
+}
+
+export class Orchestrator {
+  constructor(backend, registry = new SessionRegistry()) {
+    this.backend = backend;
+    // 이름 → 핸들 (모든 창, 파일로 유지). 없는 이름만 백엔드에서 찾는다.
+    this.registry = registry;
+    // 이번 실행에서 백엔드와 대조해 확인한 이름. tmux 서버나 Terminal 이 다시 시작되면 pane id·tty 가
+    // 다른 세션에 재사용되므로, 파일에서 읽은 핸들은 처음 쓸 때 제목(세션 이름·탭 제목)이 맞는지 확인한다.
+    this.verified = new Set();
+    // 이름 → { handle, ring, watcher }: capture --since 용 세션별 출력 링 버퍼
+    this.streams = new Map();
+    this.startedAt = Date.now();
+    this.counters = {
+      requests: 0,
+      errors: 0,
+      handleHits: 0,
+      handleMisses: 0,
+      handleEvictions: 0,
+      streamReads: 0,
+      streamBytes: 0,
+      readyWaits: 0,
+      readyWaitMs: 0,
+      readyTimeouts: 0
+    };
+  }
+
+  async resolve(name) {
+    if (!name) throw new Error('탭 이름을 입력하세요');
+    const cached = this.registry.get(name, this.backend.name);
+    if (cached && (this.verified.has(name) || this.verify(name, cached, await this.liveTitles()))) {
+      this.counters.handleHits++;
+      return cached;
+    }
+    this.counters.handleMisses++;
+    const handle = await this.backend.find(name);
+    if (!handle) throw new Error(`탭을 찾을 수 없습니다: ${name}`);
+    this.remember(name, handle);
+    return handle;
+  }
+
+  remember(name, handle) {
+    this.registry.set(name, this.backend.name, handle);
+    this.verified.add(name);
+  }
+
+  forget(name) {
+    this.registry.delete(name);
+    this.verified.delete(name);
+    this.dropStream(name);
+  }
+
+  // 살아 있는 탭/pane: handleId → 제목 (백엔드 전체 목록 한 번)
+  async liveTitles() {
+    return new Map((await this.backend.list()).map(tab => [tab.id, tab.title]));
+  }
+
+  // 핸들이 가리키는 탭/pane 이 살아 있고 제목이 등록할 때와 같으면 확인 완료, 아니면 레지스트리에서 제거
+  verify(name, handle, live) {
+    if (live.get(this.backend.handleId(handle)) === this.backend.handleTitle(handle)) {
+      this.verified.add(name);
+      return true;
+    }
+    this.counters.handleEvictions++;
+    this.forget(name);
+    return false;
+  }
+
+  // 캐시된 핸들이 닫힌 탭을 가리킨다고 백엔드가 알려 온 경우에만 한 번 다시 찾아서 재시도
+  // (시간 초과 등 다른 실패는 입력이 이미 전달됐을 수 있으므로 다시 보내지 않음)
+  async withHandle(name, fn) {
+    const handle = await this.resolve(name);
+    try {
+      return await fn(handle);
+    } catch (error) {
+      if (error.code !== HANDLE_GONE || this.registry.get(name, this.backend.name) !== handle) throw error;
+      this.forget(name);
+      return fn(await this.resolve(name));
+    }
+  }
+
+  async create(name) {
+    this.remember(name, await this.backend.create(name));
+    // 셸이 뜨는 동안의 출력도 받도록 감시만 붙여 두고 바로 돌아감 (프롬프트는 첫 send-claude 가 기다림)
+    await this.stream(name);
+    return '';
+  }
+
+  // 입력 대기 상태면 true, 아니면 유휴로 볼 때까지 남은 ms (패턴만 쓰거나 아직 빈 화면이면 Infinity: 출력이 더 와야 함)
+  // 셸이 뜨는 동안 아무것도 출력하지 않는 경우가 있어 빈 화면은 유휴로 보지 않는다.
+  isReady(ring) {
+    const tail = ring.read(Math.max(ring.start, ring.end - READY_TAIL_BYTES)).data.toString('utf8').replace(/\s+$/, '');
+    if (READY_PATTERN.test(tail.split('\n').slice(-READY_LINES).join('\n'))) return true;
+    if (IDLE_MS <= 0 || tail === '') return Infinity;
+    const idleIn = ring.updatedAt + IDLE_MS - Date.now();
+    return idleIn <= 0 || idleIn;
+  }
+
+  // 세션 출력이 조건을 만족할 때까지 대기. 시간 초과여도 실패로 보지 않고 진행 (기존 고정 대기와 같은 동작)
+  // condition 은 true 또는 다시 확인할 만한 시점까지의 ms 를 돌려준다 (Infinity: 새 출력이 올 때까지).
+  // 출력을 밀어 주는 백엔드(tmux)는 새 출력이 링 버퍼에 들어오거나 그 시점이 되면 깨어나고,
+  // Terminal 은 새 출력이 없을수록 간격을 늘려 가며 폴링한다.
+  async waitFor(name, condition, timeoutMs = READY_TIMEOUT_MS) {
+    const startedAt = Date.now();
+    let ring = await this.stream(name);
+    let pollMs = POLL_MS;
+    for (;;) {
+      const recheckIn = condition(ring);
+      if (recheckIn === true) break;
+      const remaining = timeoutMs - (Date.now() - startedAt);
+      if (remaining <= 0) {
+        this.counters.readyTimeouts++;
+        break;
+      }
+      if (this.backend.streaming) {
+        await ring.nextAppend(Math.min(recheckIn, remaining));
+        continue;
+      }
+      await new Promise(resolve => setTimeout(resolve, Math.min(pollMs, recheckIn, remaining)));
+      const { end } = ring;
+      ring = await this.stream(name);
+      pollMs = ring.end === end ? Math.min(pollMs * 2, MAX_POLL_MS) : POLL_MS;
+    }
+    this.counters.readyWaits++;
+    this.counters.readyWaitMs += Date.now() - startedAt;
+    return ring;
+  }
+
+  // 입력을 받을 상태가 되면 메시지를 입력하고, 입력이 화면에 반영된 뒤 Enter
+  async sendClaude(name, text) {
+    const { end } = await this.waitFor(name, ring => this.isReady(ring));
+    await this.withHandle(name, handle => this.backend.type(handle, text));
+    await this.waitFor(name, ring => {
+      if (ring.end <= end) return Infinity;
+      const settleIn = ring.updatedAt + SETTLE_MS - Date.now();
+      return settleIn <= 0 || settleIn;
+    });
+    await this.withHandle(name, handle => this.backend.enter(handle));
+    return '';
+  }
+
+  async kill(name) {
+    await this.withHandle(name, handle => this.backend.kill(handle));
+    this.forget(name);
+    return '';
+  }
+
+  // 레지스트리의 세션 중 백엔드에 아직 살아 있는 것만 (백엔드 전체 목록 한 번으로 확인하고,
+  // 닫혔거나 같은 id 가 다른 세션에 재사용된 것은 정리)
+  async list() {
+    const live = await this.liveTitles();
+    return this.registry.entries(this.backend.name)
+      .filter(([name, handle]) => this.verify(name, handle, live))
+      .map(([name]) => name);
+  }
+
+  dropStream(name) {
+    this.streams.get(name)?.watcher.then(watcher => watcher.close(), () => {});
+    this.streams.delete(name);
+  }
+
+  // 세션 출력 감시를 처음 요청될 때 붙이고, 탭이 바뀌었으면 같은 링 버퍼에 다시 붙임 (오프셋 유지)
+  async stream(name) {
+    return this.withHandle(name, async handle => {
+      let entry = this.streams.get(name);
+      if (entry?.handle !== handle) {
+        entry?.watcher.then(watcher => watcher.close(), () => {});
+        const ring = entry?.ring ?? new RingBuffer(SCROLLBACK_BYTES);
+        const sink = (text, gap) => {
+          ring.append(text);
+          if (gap) ring.markGap();
+        };
+        entry = { handle, ring, watcher: this.backend.watch(handle, sink) };
+        this.streams.set(name, entry);
+      }
+      try {
+        await (await entry.watcher).poll();
+      } catch (error) {
+        if (this.streams.get(name) === entry) this.streams.set(name, { ...entry, handle: null });
+        throw error;
+      }
+      return entry.ring;
+    });
+  }
+
+  // 커서 이후의 새 출력만 돌려줌. 첫 줄은 다음 커서 (덮어써졌거나 빠진 구간이 있으면 truncated)
+  async captureSince(name, cursor) {
+    const ring = await this.stream(name);
+    const { data, cursor: next, truncated } = ring.read(Number(cursor || 0));
+    this.counters.streamReads++;
+    this.counters.streamBytes += data.length;
+    return `@cursor ${next}${truncated ? ' truncated' : ''}\n${data.toString('utf8')}`;
+  }
+
+  close() {
+    for (const { watcher } of this.streams.values()) {
+      watcher.then(watcher => watcher.close(), () => {});
+    }
+    this.backend.close();
+  }
+
+  async handle([verb, ...args]) {
+    switch (verb) {
+      case 'ping':
+        return 'pong';
+      case 'new-session':
+        return this.create(args[0] || 'default');
+      case 'new-tab':
+        return this.create(args[0] || 'new-tab');
+      case 'send-keys':
+        return this.withHandle(args[0], handle => this.backend.send(handle, args[1] ?? '')).then(() => '');
+      case 'send-claude':
+        return this.sendClaude(args[0], args[1] ?? '');
+      case 'list-tabs':
+        return (await this.list()).map((name, i) => `Tab ${i + 1}: ${name}`).join('\n');
+      case 'kill-session':
+        return this.kill(args[0]);
+      case 'capture':
+        if (args[1] === '--since') return this.captureSince(args[0], args[2]);
+        return this.withHandle(args[0], handle => this.backend.capture(handle, Number(args[1]) || 20));
+      case 'stats':
+        return JSON.stringify({
+          backend: this.backend.name,
+          uptimeSec: Math.round((Date.now() - this.startedAt) / 1000),
+          sessions: this.registry.size,
+          streams: this.streams.size,
+          readyPattern: READY_PATTERN.source,
+          ...this.counters
+        });
+      default:
+        throw new Error(`알 수 없는 명령어: ${verb}`);
+    }
+  }
+
+  async execute(args) {
+    this.counters.requests++;
+    try {
+      return { code: 0, output: await this.handle(args) };
+    } catch (error) {
+      this.counters.errors++;
+      return { code: 1, output: `❌ ${error.message}` };
+    }
+  }
+}
+
+export const BACKEND = process.env.ORCH_BACKEND || (process.platform === 'darwin' ? 'terminal' : 'tmux');
+
+function createBackend() {
+  if (BACKEND === 'terminal') return new TerminalBackend();
+  if (BACKEND === 'tmux') return new TmuxBackend();
+  throw new Error(`알 수 없는 백엔드: ${BACKEND} (terminal, tmux)`);
+}
+
+function serve() {
+  const orchestrator = new Orchestrator(createBackend());
+  const server = net.createServer(socket => {
+    let buffer = Buffer.alloc(0);
+    socket.on('data', async chunk => {
+      buffer = Buffer.concat([buffer, chunk]);
+      const args = decodeRequest(buffer);
+      if (!args) return;
+      socket.pause();
+      if (args[0] === 'shutdown') {
+        socket.end('0\n');
+        server.close();
+        orchestrator.close();
+        return;
+      }
+      const { code, output } = await orchestrator.execute(args);
+      socket.end(`${code}\n${output}${output && !output.endsWith('\n') ? '\n' : ''}`);
+    });
+    socket.on('error', () => {});
+  });
+
+  server.on('error', error => {
+    console.error(`❌ 데몬 시작 실패: ${error.message}`);
+    process.exit(1);
+  });
+  // ORCH_SOCKET 이 공유 디렉터리를 가리켜도 소켓 자체는 본인만 접속 가능(0600)하도록 만든 채로 bind
+  const umask = process.umask(0o177);
+  server.listen(SOCKET_PATH, () => console.log(`✅ 제어 데몬 대기 중: ${SOCKET_PATH} (${BACKEND})`));
+  process.umask(umask);
+  server.on('close', () => process.exit(0));
+  for (const signal of ['SIGINT', 'SIGTERM']) {
+    process.on(signal, () => {
+      orchestrator.close();
+      server.close();
+    });
+  }
+}
+
+// 응답 본문을 그대로 돌려줌 (연결 실패 시, 또는 다른 사용자가 만든 소켓이면 reject)
+export function call(args) {
+  return new Promise((resolve, reject) => {
+    try {
+      if (statSync(SOCKET_PATH).uid !== process.getuid()) {
+        throw new Error(`다른 사용자의 소켓입니다: ${SOCKET_PATH}`);
+      }
+    } catch (error) {
+      reject(error);
+      return;
+    }
+    const socket = net.connect(SOCKET_PATH);
+    const chunks = [];
+    socket.on('connect', () => socket.write(encodeRequest(args)));
+    socket.on('data', chunk => chunks.push(chunk));
+    socket.on('end', () => resolve(Buffer.concat(chunks).toString('utf8')));
+    socket.on('error', reject);
+  });
+}
+
+async function isRunning() {
+  return call(['ping']).then(() => true, () => false);
+}
+
+async function main(command) {
+  if (command === 'run' || command === 'start') {
+    ensurePrivateDir(RUNTIME_DIR);
+  }
+  if (command === 'run') {
+    if (await isRunning()) {
+      console.error(`❌ 이미 실행 중입니다: ${SOCKET_PATH}`);
+      process.exit(1);
+    }
+    // 이전 실행이 남긴 소켓 파일 정리
+    try {
+      unlinkSync(SOCKET_PATH);
+    } catch (error) {
+      // 없음
+    }
+    serve();
+  } else if (command === 'start') {
+    if (await isRunning()) {
+      console.log(`✅ 이미 실행 중: ${SOCKET_PATH}`);
+      return;
+    }
+    const log = openSync(LOG_PATH, 'a', 0o600);
+    spawn(process.execPath, [fileURLToPath(import.meta.url), 'run'], {
+      detached: true,
+      stdio: ['ignore', log, log]
+    }).unref();
+    const deadline = Date.now() + START_TIMEOUT_MS;
+    while (Date.now() < deadline) {
+      if (await isRunning()) {
+        console.log(`✅ 제어 데몬 시작: ${SOCKET_PATH}`);
+        return;
+      }
+      await new Promise(resolve => setTimeout(resolve, 50));
+    }
+    console.error(`❌ 제어 데몬이 시작되지 않았습니다 (로그: ${LOG_PATH})`);
+    process.exit(1);
+  } else if (command === 'stop') {
+    await call(['shutdown']).then(() => console.log('🛑 제어 데몬 종료'), () => console.log('ℹ️  실행 중인 데몬이 없습니다'));
+  } else if (command === 'status') {
+    const stats = await call(['stats']).catch(() => null);
+    if (!stats) {
+      console.log('ℹ️  실행 중인 데몬이 없습니다');
+      process.exit(1);
+    }
+    console.log(stats.split('\n').slice(1).join('\n').trim());
+  } else if (command === 'pipe') {
+    // nc 가 없는 환경용: 표준 입력의 요청을 소켓으로 전달하고 응답을 그대로 출력
+    const chunks = [];
+    for await (const chunk of process.stdin) chunks.push(chunk);
+    const args = decodeRequest(Buffer.concat(chunks));
+    process.stdout.write(await call(args ?? []));
+  } else {
+    console.log('사용법: node orchestrator-daemon.mjs run|start|stop|status');
+    process.exit(command ? 1 : 0);
+  }
+}
+
+if (process.argv[1] === fileURLToPath(import.meta.url)) {
+  main(process.argv[2]).catch(error => {
+    console.error(`❌ ${error.message}`);
+    process.exit(1);
+  });
+}
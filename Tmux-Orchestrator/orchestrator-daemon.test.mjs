@@ -0,0 +1,263 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { SessionRegistry, handleGone } from './session-registry.mjs';
+
+// 입력 대기 판단 시간을 줄여 둔 채로 불러옴 (모듈을 읽을 때 환경 변수를 읽음)
+process.env.ORCH_IDLE_MS = '100';
+process.env.ORCH_READY_TIMEOUT_MS = '400';
+const { Orchestrator, decodeRequest, encodeRequest } = await import('./orchestrator-daemon.mjs');
+
+// 탭 목록을 메모리에 두는 백엔드. 핸들은 { id, title }, 입력은 calls 에 기록
+// type 한 텍스트는 잠시 뒤 화면에 반영(출력)되고, streaming 이 아니면 출력은 poll 때 전달된다.
+class FakeBackend {
+  constructor() {
+    this.name = 'fake';
+    this.streaming = true;
+    this.tabs = new Map();
+    this.nextId = 1;
+    this.calls = [];
+    this.listCalls = 0;
+    this.fail = null; // 다음 입력 명령에서 던질 오류
+  }
+
+  open(title) {
+    const id = `%${this.nextId++}`;
+    this.tabs.set(id, { title, sink: null, queued: [] });
+    return { id, title };
+  }
+
+  async create(name) {
+    return this.open(name);
+  }
+
+  async find(name) {
+    const found = [...this.tabs].find(([, tab]) => tab.title === name);
+    return found ? { id: found[0], title: name } : null;
+  }
+
+  handleId({ id }) {
+    return id;
+  }
+
+  handleTitle({ title }) {
+    return title;
+  }
+
+  async list() {
+    this.listCalls++;
+    return [...this.tabs].map(([id, { title }]) => ({ id, title }));
+  }
+
+  input(verb, handle, text) {
+    this.calls.push([verb, handle.id, text]);
+    if (this.fail) {
+      const error = this.fail;
+      this.fail = null;
+      throw error;
+    }
+    if (!this.tabs.has(handle.id)) throw handleGone(`pane 이 닫혔습니다: ${handle.id}`);
+    return true;
+  }
+
+  async send(handle, text) {
+    return this.input('send', handle, text);
+  }
+
+  async type(handle, text) {
+    this.input('type', handle, text);
+    setTimeout(() => this.output(handle.id, text), 5);
+    return true;
+  }
+
+  async enter(handle) {
+    return this.input('enter', handle);
+  }
+
+  async kill(handle) {
+    this.input('kill', handle);
+    this.tabs.delete(handle.id);
+    return true;
+  }
+
+  async watch(handle, sink) {
+    const tab = this.tabs.get(handle.id);
+    tab.sink = sink;
+    return {
+      poll: async () => {
+        this.polls = (this.polls ?? 0) + 1;
+        sink(tab.queued.splice(0).join(''));
+      },
+      close: () => {}
+    };
+  }
+
+  output(id, text) {
+    const tab = this.tabs.get(id);
+    if (this.streaming) {
+      tab.sink(text);
+    } else {
+      tab.queued.push(text);
+    }
+  }
+
+  close() {}
+}
+
+function setup(t) {
+  const dir = mkdtempSync(join(tmpdir(), 'orch-test-'));
+  t.after(() => rmSync(dir, { recursive: true, force: true }));
+  const backend = new FakeBackend();
+  const registryPath = join(dir, 'sessions.json');
+  const orchestrator = new Orchestrator(backend, new SessionRegistry(registryPath));
+  // 데몬 재시작: 같은 레지스트리 파일을 새로 읽는 Orchestrator
+  const restart = () => new Orchestrator(backend, new SessionRegistry(registryPath));
+  return { backend, orchestrator, restart };
+}
+
+test('요청은 인자 개수와 인자를 NUL 로 끝맺어 보내고, 다 받기 전에는 null', () => {
+  const request = encodeRequest(['send-keys', '팀 1', 'echo "a\nb"', '']);
+  assert.deepEqual(decodeRequest(request), ['send-keys', '팀 1', 'echo "a\nb"', '']);
+  for (const end of [0, 1, 5, request.length - 1]) {
+    assert.equal(decodeRequest(request.subarray(0, end)), null, `${end} 바이트까지`);
+  }
+  assert.deepEqual(decodeRequest(encodeRequest([])), []);
+  assert.equal(decodeRequest(Buffer.from('x\0a\0')), null, '개수가 숫자가 아님');
+});
+
+test('캐시된 핸들의 탭이 닫혔으면(HANDLE_GONE) 이름으로 다시 찾아 한 번 재시도', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  backend.tabs.delete('%1');
+  backend.open('팀');
+  assert.deepEqual(await orchestrator.execute(['send-keys', '팀', 'ls']), { code: 0, output: '' });
+  assert.deepEqual(backend.calls, [['send', '%1', 'ls'], ['send', '%2', 'ls']]);
+  assert.equal(orchestrator.registry.get('팀', 'fake').id, '%2');
+});
+
+test('그 밖의 실패는 입력이 이미 들어갔을 수 있으므로 다시 보내지 않음', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  backend.fail = new Error('시간 초과');
+  assert.deepEqual(await orchestrator.execute(['send-keys', '팀', 'ls']), { code: 1, output: '❌ 시간 초과' });
+  assert.deepEqual(backend.calls, [['send', '%1', 'ls']]);
+  assert.equal(orchestrator.registry.get('팀', 'fake').id, '%1', '핸들은 그대로');
+});
+
+test('닫힌 탭을 다시 찾지 못하면 오류', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  backend.tabs.delete('%1');
+  const { code, output } = await orchestrator.execute(['send-keys', '팀', 'ls']);
+  assert.equal(code, 1);
+  assert.match(output, /탭을 찾을 수 없습니다: 팀/);
+  assert.equal(backend.calls.length, 1);
+});
+
+test('재시작 뒤 파일의 핸들은 처음 쓸 때 제목을 대조하고, 다른 세션에 재사용된 id 면 버리고 이름으로 다시 찾음', async t => {
+  const { backend, orchestrator, restart } = setup(t);
+  await orchestrator.create('팀');
+  // tmux 서버 재시작: %1 은 다른 세션, 같은 이름의 세션은 %2
+  backend.tabs.clear();
+  backend.nextId = 1;
+  backend.open('남의 세션');
+  backend.open('팀');
+  const restarted = restart();
+  assert.deepEqual(await restarted.execute(['send-keys', '팀', 'ls']), { code: 0, output: '' });
+  assert.deepEqual(backend.calls, [['send', '%2', 'ls']], '재사용된 %1 에는 입력하지 않음');
+  assert.equal(restarted.counters.handleEvictions, 1);
+  assert.equal(restart().registry.get('팀', 'fake').id, '%2', '파일도 갱신');
+
+  const { listCalls } = backend;
+  await restarted.execute(['send-keys', '팀', 'pwd']);
+  assert.equal(backend.listCalls, listCalls, '한 번 확인한 핸들은 다시 대조하지 않음');
+  assert.equal(restarted.counters.handleHits, 1);
+});
+
+test('재사용된 id 만 있고 같은 이름의 세션이 없으면 입력하지 않고 오류', async t => {
+  const { backend, orchestrator, restart } = setup(t);
+  await orchestrator.create('팀');
+  backend.tabs.clear();
+  backend.nextId = 1;
+  backend.open('남의 세션');
+  const { code, output } = await restart().execute(['send-keys', '팀', 'ls']);
+  assert.equal(code, 1);
+  assert.match(output, /탭을 찾을 수 없습니다/);
+  assert.deepEqual(backend.calls, []);
+});
+
+test('list-tabs 는 살아 있고 제목이 맞는 세션만 생성 순서로 보여 주고 나머지는 정리', async t => {
+  const { backend, orchestrator, restart } = setup(t);
+  for (const name of ['a', 'b', 'c']) await orchestrator.create(name);
+  backend.tabs.delete('%2');
+  backend.tabs.get('%3').title = 'x';
+  const restarted = restart();
+  assert.deepEqual(await restarted.execute(['list-tabs']), { code: 0, output: 'Tab 1: a' });
+  assert.equal(restarted.counters.handleEvictions, 2);
+  assert.deepEqual(restart().registry.entries('fake').map(([name]) => name), ['a']);
+});
+
+const sleep = ms => new Promise(resolve => setTimeout(resolve, ms));
+
+// send-claude 를 보내고 [걸린 ms, 입력 기록]
+async function sendClaude(orchestrator, backend, name, text) {
+  const startedAt = Date.now();
+  assert.deepEqual(await orchestrator.execute(['send-claude', name, text]), { code: 0, output: '' });
+  return [Date.now() - startedAt, backend.calls.filter(([verb]) => verb !== 'send')];
+}
+
+test('프롬프트가 보이면 유휴 시간을 기다리지 않고 입력하고, 입력이 반영되면 바로 Enter', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  setTimeout(() => backend.output('%1', '준비 중...\nuser@host:~$ '), 20);
+  const [elapsed, calls] = await sendClaude(orchestrator, backend, '팀', '안녕');
+  assert.deepEqual(calls, [['type', '%1', '안녕'], ['enter', '%1', undefined]]);
+  assert.ok(elapsed < 100 + 50, `${elapsed}ms: 유휴 판단(100ms)보다 먼저 입력`);
+  assert.equal(orchestrator.counters.readyTimeouts, 0);
+  assert.equal(orchestrator.counters.readyWaits, 2);
+});
+
+test('프롬프트가 없으면 출력이 멈춘 뒤 유휴 시간이 지나야 입력', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  backend.output('%1', 'loading');
+  setTimeout(() => backend.output('%1', '...'), 60);
+  const [elapsed, calls] = await sendClaude(orchestrator, backend, '팀', 'hi');
+  assert.equal(calls.length, 2);
+  assert.ok(elapsed >= 60 + 100 - 10 && elapsed < 400, `${elapsed}ms`);
+  assert.equal(orchestrator.counters.readyTimeouts, 0);
+});
+
+test('빈 화면은 유휴로 보지 않고, 준비 신호가 없으면 제한 시간 뒤 그대로 진행', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  backend.type = async (handle, text) => backend.input('type', handle, text); // 입력이 화면에 반영되지 않음
+  const [elapsed, calls] = await sendClaude(orchestrator, backend, '팀', 'hi');
+  assert.deepEqual(calls.map(([verb]) => verb), ['type', 'enter']);
+  assert.ok(elapsed >= 2 * 400 - 20, `${elapsed}ms: 입력 전·Enter 전 모두 제한 시간까지 대기`);
+  assert.equal(orchestrator.counters.readyTimeouts, 2);
+});
+
+test('프롬프트 판단은 출력 끝부분만 봄 (앞쪽의 프롬프트 뒤로 출력이 이어지면 준비 아님)', async t => {
+  const { backend, orchestrator } = setup(t);
+  await orchestrator.create('팀');
+  backend.output('%1', '$ \n' + 'x'.repeat(600));
+  const ring = await orchestrator.stream('팀');
+  assert.equal(typeof orchestrator.isReady(ring), 'number');
+  backend.output('%1', '\n> ');
+  assert.equal(orchestrator.isReady(ring), true);
+});
+
+test('출력을 밀어 주지 않는 백엔드는 poll 로 새 출력을 확인하며 대기', async t => {
+  const { backend, orchestrator } = setup(t);
+  backend.streaming = false;
+  await orchestrator.create('팀');
+  setTimeout(() => backend.output('%1', 'user@host:~$ '), 30);
+  const [elapsed, calls] = await sendClaude(orchestrator, backend, '팀', 'hi');
+  assert.equal(calls.length, 2);
+  assert.ok(elapsed < 400, `${elapsed}ms`);
+  assert.ok(backend.polls >= 3);
+  assert.equal(orchestrator.counters.readyTimeouts, 0);
+});
@@ -0,0 +1,75 @@
+// 세션 출력용 고정 크기 링 버퍼
+// 지금까지 기록된 전체 바이트 수를 오프셋(커서)으로 쓰며, 오프셋은 계속 증가한다.
+// 용량을 넘긴 오래된 바이트는 덮어쓰고, 그보다 앞선 커서로 읽으면 남아 있는 가장 오래된 위치부터 돌려준다.
+
+export class RingBuffer {
+  constructor(capacity) {
+    this.capacity = capacity;
+    this.buffer = Buffer.alloc(capacity);
+    this.end = 0; // 다음에 기록될 바이트의 오프셋
+    this.updatedAt = Date.now(); // 마지막으로 출력이 들어온 시각 (유휴 판단용)
+    this.gapAt = 0; // 이 오프셋보다 앞선 커서와 지금 사이에는 빠진 출력이 있음
+    this.waiters = new Set();
+  }
+
+  // 아직 남아 있는 가장 오래된 바이트의 오프셋
+  get start() {
+    return Math.max(0, this.end - this.capacity);
+  }
+
+  append(data) {
+    let bytes = Buffer.isBuffer(data) ? data : Buffer.from(String(data), 'utf8');
+    if (bytes.length === 0) return this.end;
+    let offset = this.end;
+    if (bytes.length > this.capacity) {
+      offset += bytes.length - this.capacity;
+      bytes = bytes.subarray(bytes.length - this.capacity);
+    }
+    const position = offset % this.capacity;
+    const first = Math.min(bytes.length, this.capacity - position);
+    bytes.copy(this.buffer, position, 0, first);
+    bytes.copy(this.buffer, 0, first);
+    this.end = offset + bytes.length;
+    this.updatedAt = Date.now();
+    for (const wake of [...this.waiters]) wake();
+    return this.end;
+  }
+
+  // 다음 append 까지 (길어야 timeoutMs) 대기
+  nextAppend(timeoutMs) {
+    return new Promise(resolve => {
+      const wake = () => {
+        clearTimeout(timer);
+        this.waiters.delete(wake);
+        resolve();
+      };
+      const timer = setTimeout(wake, timeoutMs);
+      this.waiters.add(wake);
+    });
+  }
+
+  // 출력원이 중간 출력을 놓쳤음을 알림 (지금까지 기록된 위치보다 앞선 커서로 읽으면 truncated)
+  markGap() {
+    this.gapAt = this.end;
+  }
+
+  // since 이후의 바이트와 다음 커서. since 가 범위를 벗어나면(덮어써졌거나 데몬 재시작 전 커서)
+  // 남아 있는 가장 오래된 위치부터 돌려주고 truncated, 중간에 빠진 출력이 있어도 truncated
+  read(since) {
+    const outOfRange = !(since >= this.start && since <= this.end);
+    const truncated = outOfRange || since < this.gapAt;
+    let from = outOfRange ? this.start : since;
+    const data = Buffer.alloc(this.end - from);
+    const position = from % this.capacity;
+    const first = Math.min(data.length, this.capacity - position);
+    this.buffer.copy(data, 0, position, position + first);
+    this.buffer.copy(data, first, 0, data.length - first);
+    // 덮어쓰기 경계에서 잘린 UTF-8 문자의 나머지 바이트는 버림
+    let skip = 0;
+    if (outOfRange) {
+      while (skip < data.length && skip < 3 && (data[skip] & 0xc0) === 0x80) skip++;
+      from += skip;
+    }
+    return { data: data.subarray(skip), from, cursor: this.end, truncated };
+  }
+}
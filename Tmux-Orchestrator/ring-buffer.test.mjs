@@ -0,0 +1,64 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { RingBuffer } from './ring-buffer.mjs';
+
+function read(ring, since) {
+  const { data, ...rest } = ring.read(since);
+  return { text: data.toString('utf8'), ...rest };
+}
+
+test('커서 이후의 출력과 다음 커서', () => {
+  const ring = new RingBuffer(16);
+  assert.equal(ring.append('hello '), 6);
+  assert.equal(ring.append('world'), 11);
+  assert.deepEqual(read(ring, 0), { text: 'hello world', from: 0, cursor: 11, truncated: false });
+  assert.deepEqual(read(ring, 6), { text: 'world', from: 6, cursor: 11, truncated: false });
+  assert.deepEqual(read(ring, 11), { text: '', from: 11, cursor: 11, truncated: false });
+});
+
+test('용량을 넘으면 경계를 넘어 이어 쓰고, 덮어쓴 커서로 읽으면 남은 부분부터 truncated', () => {
+  const ring = new RingBuffer(8);
+  ring.append('abcdef');
+  ring.append('ghij');
+  assert.equal(ring.start, 2);
+  assert.deepEqual(read(ring, 4), { text: 'efghij', from: 4, cursor: 10, truncated: false });
+  assert.deepEqual(read(ring, 0), { text: 'cdefghij', from: 2, cursor: 10, truncated: true });
+  assert.deepEqual(read(ring, 99), { text: 'cdefghij', from: 2, cursor: 10, truncated: true }, '데몬 재시작 전 커서');
+  ring.append('0123456789ab');
+  assert.deepEqual(read(ring, 10), { text: '456789ab', from: 14, cursor: 22, truncated: true }, '용량보다 큰 출력은 끝부분만');
+});
+
+test('덮어쓰기 경계에서 잘린 UTF-8 문자의 나머지 바이트는 버림', () => {
+  const ring = new RingBuffer(8);
+  ring.append('ab한글'); // 2 + 3 + 3 바이트
+  ring.append('cde'); // '한' 의 첫 바이트가 밀려남
+  const { text, from, truncated } = read(ring, 0);
+  assert.equal(text, '글cde');
+  assert.equal(from, 5);
+  assert.equal(truncated, true);
+});
+
+test('빠진 출력(markGap) 이전 커서로 읽으면 truncated', () => {
+  const ring = new RingBuffer(64);
+  ring.append('첫 화면\n');
+  const before = ring.end;
+  ring.append('\n마지막 화면');
+  ring.markGap();
+  assert.equal(read(ring, 0).truncated, true);
+  assert.equal(read(ring, before).truncated, true);
+  assert.equal(read(ring, ring.end).truncated, false);
+  ring.append('\n다음');
+  assert.deepEqual(read(ring, ring.end - 7), { text: '\n다음', from: ring.end - 7, cursor: ring.end, truncated: false });
+});
+
+test('nextAppend 는 출력이 들어오면 바로, 없으면 제한 시간 뒤 깨어남', async () => {
+  const ring = new RingBuffer(64);
+  let startedAt = Date.now();
+  setTimeout(() => ring.append('x'), 10);
+  await ring.nextAppend(1000);
+  assert.ok(Date.now() - startedAt < 500);
+  startedAt = Date.now();
+  await ring.nextAppend(30);
+  assert.ok(Date.now() - startedAt >= 25);
+  assert.equal(ring.waiters.size, 0);
+});
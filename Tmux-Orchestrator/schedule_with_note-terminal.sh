@@ -26,13 +26,13 @@ echo "🎯 대상 탭: $TARGET_TAB"
 # at 명령어가 있는지 확인
 if command -v at >/dev/null 2>&1; then
     # at 명령어 사용
-    echo "osascript '$SCRIPT_DIR/terminal-control.applescript' 'send-claude' '$TARGET_TAB' '⏰ 스케줄된 체크인: $NOTE (예정시간: $CURRENT_TIME + ${MINUTES}분)'" | at now + ${MINUTES} minutes
+    echo "'$SCRIPT_DIR/send-claude-message-terminal.sh' '$TARGET_TAB' '⏰ 스케줄된 체크인: $NOTE (예정시간: $CURRENT_TIME + ${MINUTES}분)'" | at now + ${MINUTES} minutes
     echo "✅ at 명령어로 스케줄 설정 완료"
 elif command -v sleep >/dev/null 2>&1; then
     # 백그라운드에서 sleep 사용
     (
         sleep $((MINUTES * 60))
-        osascript "$SCRIPT_DIR/terminal-control.applescript" "send-claude" "$TARGET_TAB" "⏰ 스케줄된 체크인: $NOTE (예정시간: $CURRENT_TIME + ${MINUTES}분)"
+        "$SCRIPT_DIR/send-claude-message-terminal.sh" "$TARGET_TAB" "⏰ 스케줄된 체크인: $NOTE (예정시간: $CURRENT_TIME + ${MINUTES}분)" >/dev/null
         echo "✅ 스케줄된 메시지 전송 완료: $TARGET_TAB" >> "$SCRIPT_DIR/schedule.log"
     ) &
     
@@ -14,9 +14,10 @@ fi
 TAB_NAME="$1"
 MESSAGE="$2"
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+source "$SCRIPT_DIR/orchestrator-client.sh"
 
-# AppleScript를 사용하여 메시지 전송
-osascript "$SCRIPT_DIR/terminal-control.applescript" "send-claude" "$TAB_NAME" "$MESSAGE"
+# 제어 데몬을 통해 메시지 전송 (데몬이 없으면 AppleScript 직접 실행)
+orch_call "send-claude" "$TAB_NAME" "$MESSAGE"
 
 if [ $? -eq 0 ]; then
     echo "✅ 메시지 전송 완료: $TAB_NAME"
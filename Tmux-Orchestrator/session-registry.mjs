@@ -0,0 +1,72 @@
+// 세션 이름 → 백엔드 핸들 레지스트리
+// 생성·종료 때 갱신하고 JSON 파일로 남겨 데몬을 다시 띄워도 이름으로 바로 핸들을 찾는다.
+// 파일: { "version": 1, "sessions": { "<이름>": { "backend": "tmux", "handle": {...}, "createdAt": ... } } }
+
+import { mkdirSync, readFileSync, renameSync, writeFileSync } from 'fs';
+import { homedir } from 'os';
+import { dirname, join } from 'path';
+
+export const REGISTRY_PATH = process.env.ORCH_REGISTRY || join(homedir(), '.terminal-orchestrator', 'sessions.json');
+
+// 백엔드가 "핸들이 가리키는 탭/pane 이 더 이상 없음"을 알릴 때 쓰는 오류 코드.
+// 이 코드가 붙은 오류만 이름으로 다시 찾아 재시도한다 (그 밖의 실패는 입력이 이미 들어갔을 수 있음).
+export const HANDLE_GONE = 'ORCH_HANDLE_GONE';
+
+export function handleGone(message) {
+  return Object.assign(new Error(message), { code: HANDLE_GONE });
+}
+
+export class SessionRegistry {
+  constructor(path = REGISTRY_PATH) {
+    this.path = path;
+    this.sessions = new Map();
+    try {
+      const data = JSON.parse(readFileSync(path, 'utf8'));
+      for (const [name, entry] of Object.entries(data.sessions || {})) {
+        this.sessions.set(name, entry);
+      }
+    } catch (error) {
+      // 처음 실행이거나 손상된 파일 → 빈 레지스트리로 시작
+    }
+  }
+
+  get size() {
+    return this.sessions.size;
+  }
+
+  // 지정한 백엔드에 속한 핸들만 돌려줌 (다른 백엔드로 만든 같은 이름은 없는 것으로 취급)
+  get(name, backend) {
+    const entry = this.sessions.get(name);
+    return entry && entry.backend === backend ? entry.handle : null;
+  }
+
+  set(name, backend, handle) {
+    const previous = this.sessions.get(name);
+    this.sessions.set(name, {
+      backend,
+      handle,
+      createdAt: previous?.backend === backend ? previous.createdAt : Date.now()
+    });
+    this.save();
+  }
+
+  delete(name) {
+    if (this.sessions.delete(name)) this.save();
+  }
+
+  // 생성 순서대로 [이름, 핸들]
+  entries(backend) {
+    return [...this.sessions]
+      .filter(([, entry]) => entry.backend === backend)
+      .sort(([, a], [, b]) => a.createdAt - b.createdAt)
+      .map(([name, entry]) => [name, entry.handle]);
+  }
+
+  // 임시 파일에 쓴 뒤 rename 하여 읽는 쪽이 반쯤 쓰인 파일을 보지 않게 함
+  save() {
+    mkdirSync(dirname(this.path), { recursive: true });
+    const temp = `${this.path}.${process.pid}.tmp`;
+    writeFileSync(temp, JSON.stringify({ version: 1, sessions: Object.fromEntries(this.sessions) }, null, 2));
+    renameSync(temp, this.path);
+  }
+}
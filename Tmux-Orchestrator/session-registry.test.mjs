@@ -0,0 +1,47 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { mkdtempSync, readdirSync, readFileSync, rmSync, writeFileSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { SessionRegistry } from './session-registry.mjs';
+
+function tempPath(t) {
+  const dir = mkdtempSync(join(tmpdir(), 'orch-registry-test-'));
+  t.after(() => rmSync(dir, { recursive: true, force: true }));
+  return join(dir, 'nested', 'sessions.json');
+}
+
+test('변경할 때마다 파일에 남기고 다시 열면 그대로 읽음', t => {
+  const path = tempPath(t);
+  const registry = new SessionRegistry(path);
+  registry.set('팀 A', 'tmux', { pane: '%1', session: '팀 A' });
+  registry.set('팀 B', 'tmux', { pane: '%2', session: '팀 B' });
+  registry.set('팀 C', 'terminal', { tty: '/dev/ttys001', title: '팀 C' });
+  registry.delete('팀 B');
+  assert.deepEqual(readdirSync(join(path, '..')), ['sessions.json'], '임시 파일이 남지 않음');
+  assert.equal(JSON.parse(readFileSync(path, 'utf8')).version, 1);
+
+  const reloaded = new SessionRegistry(path);
+  assert.equal(reloaded.size, 2);
+  assert.deepEqual(reloaded.get('팀 A', 'tmux'), { pane: '%1', session: '팀 A' });
+  assert.equal(reloaded.get('팀 B', 'tmux'), null);
+  assert.equal(reloaded.get('팀 C', 'tmux'), null, '다른 백엔드의 같은 이름은 없는 것으로');
+  assert.deepEqual(reloaded.entries('terminal'), [['팀 C', { tty: '/dev/ttys001', title: '팀 C' }]]);
+});
+
+test('entries 는 생성 순서, 같은 백엔드로 다시 등록해도 생성 시각은 유지', async t => {
+  const registry = new SessionRegistry(tempPath(t));
+  registry.set('b', 'tmux', { pane: '%1' });
+  await new Promise(resolve => setTimeout(resolve, 5));
+  registry.set('a', 'tmux', { pane: '%2' });
+  registry.set('b', 'tmux', { pane: '%3' });
+  assert.deepEqual(registry.entries('tmux'), [['b', { pane: '%3' }], ['a', { pane: '%2' }]]);
+});
+
+test('없거나 손상된 파일이면 빈 레지스트리로 시작', t => {
+  const path = tempPath(t);
+  assert.equal(new SessionRegistry(path).size, 0);
+  new SessionRegistry(path).set('x', 'tmux', { pane: '%1' });
+  writeFileSync(path, '{ 손상');
+  assert.equal(new SessionRegistry(path).size, 0);
+});
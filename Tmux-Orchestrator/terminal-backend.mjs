@@ -0,0 +1,118 @@
+// macOS Terminal.app 백엔드
+// terminal-worker.js 를 osascript 로 한 번만 띄우고 JSON 줄 단위로 요청을 주고받는다.
+// 워커가 죽으면 다음 요청 때 다시 띄운다.
+
+import { spawn } from 'child_process';
+import { createInterface } from 'readline';
+import { dirname, join } from 'path';
+import { fileURLToPath } from 'url';
+
+const WORKER = join(dirname(fileURLToPath(import.meta.url)), 'terminal-worker.js');
+
+export class TerminalBackend {
+  constructor() {
+    this.name = 'terminal';
+    this.streaming = false; // 출력은 read 폴링으로만 받음
+    this.worker = null;
+    this.nextId = 1;
+    this.pending = new Map();
+  }
+
+  start() {
+    if (this.worker) return this.worker;
+    const worker = spawn('osascript', ['-l', 'JavaScript', WORKER], { stdio: ['pipe', 'pipe', 'inherit'] });
+    createInterface({ input: worker.stdout }).on('line', line => {
+      let response;
+      try {
+        response = JSON.parse(line);
+      } catch (error) {
+        return; // 응답이 아닌 출력 (osascript 경고 등)
+      }
+      const entry = this.pending.get(response.id);
+      if (!entry) return;
+      this.pending.delete(response.id);
+      if (response.ok) {
+        entry.resolve(response.result);
+      } else {
+        entry.reject(Object.assign(new Error(response.error), { code: response.code }));
+      }
+    });
+    worker.on('exit', () => {
+      if (this.worker === worker) this.worker = null;
+      for (const entry of this.pending.values()) {
+        entry.reject(new Error('Terminal 워커가 종료되었습니다'));
+      }
+      this.pending.clear();
+    });
+    this.worker = worker;
+    return worker;
+  }
+
+  call(verb, params = {}) {
+    const worker = this.start();
+    const id = this.nextId++;
+    return new Promise((resolve, reject) => {
+      this.pending.set(id, { resolve, reject });
+      worker.stdin.write(JSON.stringify({ id, verb, params }) + '\n');
+    });
+  }
+
+  create(name) {
+    return this.call('create', { name });
+  }
+
+  find(name) {
+    return this.call('find', { name });
+  }
+
+  handleId({ tty }) {
+    return tty;
+  }
+
+  // list() 의 title 과 비교할 값 (만들 때 붙인 탭 제목)
+  handleTitle({ title }) {
+    return title;
+  }
+
+  async list() {
+    return this.call('list');
+  }
+
+  kill(handle) {
+    return this.call('close', { handle });
+  }
+
+  send(handle, text) {
+    return this.call('send', { handle, text });
+  }
+
+  type(handle, text) {
+    return this.call('type', { handle, text });
+  }
+
+  enter(handle) {
+    return this.call('enter', { handle });
+  }
+
+  capture(handle, lines) {
+    return this.call('capture', { handle, lines });
+  }
+
+  // Terminal 은 출력 스트림이 없으므로 capture --since 때마다 워커가 새로 늘어난 부분만 잘라 보냄
+  // (첫 read 만 지금까지의 내용 전체, 이어지지 않는 구간은 gap 으로 알림)
+  async watch(handle, sink) {
+    let seed = true;
+    return {
+      poll: async () => {
+        const { text, gap } = await this.call('read', { handle, seed });
+        seed = false;
+        sink(text, gap);
+      },
+      close: () => {}
+    };
+  }
+
+  close() {
+    this.worker?.stdin.end();
+  }
+}
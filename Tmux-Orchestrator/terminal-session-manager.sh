@@ -2,8 +2,10 @@
 
 # Terminal.app 기반 세션 관리 스크립트
 # tmux 세션 관리 기능을 Terminal.app 탭으로 시뮬레이션
+# Linux 에서는 같은 명령을 tmux 세션으로 처리 (ORCH_BACKEND=terminal|tmux 로 지정 가능)
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+source "$SCRIPT_DIR/orchestrator-client.sh"
 
 # 도움말 표시
 show_help() {
@@ -13,16 +15,22 @@ Terminal Session Manager - tmux 대안 (Terminal.app 기반)
 사용법:
     $0 new-session <session_name>           새 세션(탭) 생성
     $0 new-window <session_name> <window_name>  새 윈도우(탭) 생성
-    $0 list-sessions                        모든 탭 목록 표시
+    $0 list-sessions                        등록된 모든 탭 목록 표시 (모든 창)
     $0 send-keys <tab_name> "<command>"     특정 탭에 명령어 전송
     $0 send-claude <tab_name> "<message>"   Claude에게 메시지 전송
     $0 capture <tab_name> [lines]           탭 내용 캡처
+    $0 capture <tab_name> --since <cursor>  커서 이후의 새 출력만 (첫 줄: @cursor <다음 커서>)
     $0 kill-session <tab_name>              탭 닫기
+    $0 daemon start|stop|status             제어 데몬 관리 (명령 실행 시 자동 시작)
+
+백엔드: ORCH_BACKEND=terminal (macOS 기본값, Terminal.app 탭)
+        ORCH_BACKEND=tmux     (그 밖의 OS 기본값, 탭 이름 = tmux 세션 이름)
     
 예시:
     $0 new-session "my-project"
     $0 send-claude "Claude-Agent" "안녕하세요!"
     $0 capture "Claude-Agent" 20
+    $0 capture "Claude-Agent" --since 0
     
 EOF
 }
@@ -36,7 +44,7 @@ create_session() {
     fi
     
     echo "🚀 새 세션 생성 중: $session_name"
-    osascript "$SCRIPT_DIR/terminal-control.applescript" "new-session" "$session_name"
+    orch_call "new-session" "$session_name"
     echo "✅ 세션 생성 완료: $session_name"
 }
 
@@ -50,14 +58,14 @@ create_window() {
     fi
     
     echo "📝 새 윈도우 생성 중: $window_name"
-    osascript "$SCRIPT_DIR/terminal-control.applescript" "new-tab" "$window_name"
+    orch_call "new-tab" "$window_name"
     echo "✅ 윈도우 생성 완료: $window_name"
 }
 
 # 세션 목록 표시
 list_sessions() {
     echo "📋 현재 활성 탭 목록:"
-    osascript "$SCRIPT_DIR/terminal-control.applescript" "list-tabs"
+    orch_call "list-tabs"
 }
 
 # 명령어 전송
@@ -72,7 +80,7 @@ send_keys() {
     
     echo "📤 명령어 전송 중: $tab_name"
     echo "💬 명령어: $command"
-    osascript "$SCRIPT_DIR/terminal-control.applescript" "send-keys" "$tab_name" "$command"
+    orch_call "send-keys" "$tab_name" "$command"
 }
 
 # Claude 메시지 전송
@@ -87,7 +95,7 @@ send_claude() {
     
     echo "🤖 Claude 메시지 전송 중: $tab_name"
     echo "💬 메시지: $message"
-    osascript "$SCRIPT_DIR/terminal-control.applescript" "send-claude" "$tab_name" "$message"
+    orch_call "send-claude" "$tab_name" "$message"
 }
 
 # 탭 내용 캡처
@@ -99,12 +107,18 @@ capture_output() {
         echo "❌ 탭 이름을 입력하세요"
         exit 1
     fi
+
+    # 커서 기반 캡처는 스크립트에서 파싱하므로 안내 문구 없이 그대로 출력
+    if [ "$lines" = "--since" ]; then
+        orch_call "capture" "$tab_name" "--since" "${3:-0}"
+        return
+    fi
     
     echo "📸 탭 내용 캡처 중: $tab_name (최근 $lines줄)"
-    osascript "$SCRIPT_DIR/terminal-control.applescript" "capture" "$tab_name" "$lines"
+    orch_call "capture" "$tab_name" "$lines"
 }
 
-# 탭 닫기 (수동으로 해야 함)
+# 탭 닫기 (세션 레지스트리에서도 제거)
 kill_session() {
     local tab_name="$1"
     
@@ -113,8 +127,22 @@ kill_session() {
         exit 1
     fi
     
-    echo "⚠️  탭 '$tab_name'을 수동으로 닫아주세요"
-    echo "💡 Command+W를 사용하거나 터미널에서 'exit'를 입력하세요"
+    echo "🗑  탭 닫는 중: $tab_name"
+    orch_call "kill-session" "$tab_name" || exit 1
+    echo "✅ 탭 닫기 완료: $tab_name"
+}
+
+# 제어 데몬 관리
+manage_daemon() {
+    case "$1" in
+        "start"|"stop"|"status")
+            node "$SCRIPT_DIR/orchestrator-daemon.mjs" "$1"
+            ;;
+        *)
+            echo "❌ 사용법: $0 daemon start|stop|status"
+            exit 1
+            ;;
+    esac
 }
 
 # 메인 로직
@@ -135,11 +163,14 @@ case "$1" in
         send_claude "$2" "$3"
         ;;
     "capture")
-        capture_output "$2" "$3"
+        capture_output "$2" "$3" "$4"
         ;;
     "kill-session")
         kill_session "$2"
         ;;
+    "daemon")
+        manage_daemon "$2"
+        ;;
     "help"|"-h"|"--help"|"")
         show_help
         ;;
@@ -0,0 +1,224 @@
+// Terminal.app 상주 워커 (JXA: osascript -l JavaScript terminal-worker.js)
+// 제어 데몬이 한 번 띄워 두고 표준 입력으로 JSON 요청을 한 줄씩 보낸다.
+// Terminal 스크립팅 브리지와 탭 참조를 프로세스 안에 유지하므로
+// 명령마다 osascript 를 새로 띄우고 탭을 다시 찾는 비용이 없다.
+//
+// 요청: {"id": 1, "verb": "send", "params": {...}}
+// 응답: {"id": 1, "ok": true, "result": ...} 또는 {"id": 1, "ok": false, "error": "...", "code": "..."}
+//       code 가 ORCH_HANDLE_GONE 이면 핸들의 탭이 닫힌 것 (데몬이 이름으로 다시 찾음)
+
+ObjC.import('Foundation');
+
+const terminal = Application('Terminal');
+const systemEvents = Application('System Events');
+const environment = $.NSProcessInfo.processInfo.environment;
+const WORKDIR = ObjC.unwrap(environment.objectForKey('ORCH_WORKDIR')) || '/Users/workspace/optom_research';
+
+// tty → 탭 참조 (windows.byId(id).tabs[i]); tty 는 탭이 살아 있는 동안 바뀌지 않는다
+const tabs = {};
+// tty → 직전 read 때 본 내용의 끝부분 (다음 read 에서 새로 늘어난 부분을 찾는 기준)
+const lastTails = {};
+const TAIL_CHARS = 512;
+const POLL_SEC = 0.05;
+const MAX_POLL_SEC = 0.4;
+const READY_TIMEOUT_SEC = (Number(ObjC.unwrap(environment.objectForKey('ORCH_READY_TIMEOUT_MS'))) || 5000) / 1000;
+
+// 조건이 참이 될 때까지 나눠 대기 (고정 delay 대신 상태 관찰, 간격은 두 배씩 늘림)
+function waitUntil(condition, timeoutSec) {
+  let interval = POLL_SEC;
+  for (let waited = 0; waited < timeoutSec; waited += interval, interval = Math.min(interval * 2, MAX_POLL_SEC)) {
+    if (condition()) return true;
+    delay(Math.min(interval, timeoutSec - waited));
+  }
+  return condition();
+}
+
+function tabFor(handle) {
+  const cached = tabs[handle.tty];
+  try {
+    if (cached && cached.tty() === handle.tty) {
+      return cached;
+    }
+  } catch (error) {
+    // 탭이 닫혔거나 순서가 바뀜 → 다시 찾음
+  }
+  // 창 id 와 모든 탭의 tty 를 한 번의 Apple Event 로 가져옴
+  const windowIds = terminal.windows.id();
+  const ttys = terminal.windows.tabs.tty();
+  for (let w = 0; w < windowIds.length; w++) {
+    const index = ttys[w].indexOf(handle.tty);
+    if (index !== -1) {
+      const tab = terminal.windows.byId(windowIds[w]).tabs[index];
+      tabs[handle.tty] = tab;
+      return tab;
+    }
+  }
+  delete tabs[handle.tty];
+  const error = new Error(`탭이 닫혔습니다: ${handle.tty}`);
+  error.code = 'ORCH_HANDLE_GONE';
+  throw error;
+}
+
+// 핸들: tty 와 창 id, 그리고 데몬이 재사용된 tty 를 가려낼 수 있도록 탭 제목
+function handleOf(tab, windowId, title) {
+  const tty = tab.tty();
+  tabs[tty] = tab;
+  return { tty, windowId, title };
+}
+
+// 새 터미널 탭 생성 후 작업 디렉토리로 이동하고 제목 설정
+// 프롬프트가 뜰 때까지의 대기는 데몬이 출력을 보고 처리한다
+function createNewTab(name) {
+  const frontTabs = () => (terminal.windows.length === 0 ? 0 : terminal.windows[0].tabs.length);
+  const before = frontTabs();
+  terminal.activate();
+  systemEvents.keystroke('t', { using: 'command down' });
+  if (!waitUntil(() => frontTabs() > before, READY_TIMEOUT_SEC)) {
+    throw new Error('새 탭이 열리지 않았습니다');
+  }
+
+  const windowId = terminal.windows[0].id();
+  const window = terminal.windows.byId(windowId);
+  const tab = window.tabs[window.tabs.length - 1];
+  terminal.doScript(`cd ${WORKDIR}`, { in: tab });
+  tab.customTitle = name;
+  return handleOf(tab, windowId, name);
+}
+
+// 탭 이름으로 찾기 (모든 창의 id 와 제목을 두 번의 Apple Event 로 가져와 비교)
+function findTabByName(name) {
+  const windowIds = terminal.windows.id();
+  const titles = terminal.windows.tabs.customTitle();
+  for (let w = 0; w < windowIds.length; w++) {
+    const index = titles[w].indexOf(name);
+    if (index !== -1) {
+      return handleOf(terminal.windows.byId(windowIds[w]).tabs[index], windowIds[w], name);
+    }
+  }
+  return null;
+}
+
+// 모든 창의 탭을 [{ title, id: tty }]
+function getTabList() {
+  const titles = terminal.windows.tabs.customTitle();
+  const ttys = terminal.windows.tabs.tty();
+  const list = [];
+  for (let w = 0; w < titles.length; w++) {
+    for (let t = 0; t < titles[w].length; t++) {
+      list.push({ title: titles[w][t], id: ttys[w][t] });
+    }
+  }
+  return list;
+}
+
+// Terminal 스크립팅에는 탭 닫기가 없음: 창에 탭이 하나뿐이면 창을 닫고, 아니면 탭을 선택해 앞으로 가져온 뒤
+// 맨 앞 탭이 이 tty 인 것을 확인하고 Command+W (포커스가 다른 곳으로 가 있으면 다른 탭이 닫히므로 누르지 않음)
+function closeTab(handle) {
+  const tab = tabFor(handle);
+  const windowIds = terminal.windows.id();
+  const ttys = terminal.windows.tabs.tty();
+  const w = ttys.findIndex(list => list.includes(handle.tty));
+  const window = terminal.windows.byId(windowIds[w]);
+  if (ttys[w].length === 1) {
+    window.close();
+  } else {
+    window.selectedTab = tab;
+    window.index = 1;
+    terminal.activate();
+    const focused = () => terminal.frontmost() && terminal.windows[0].selectedTab.tty() === handle.tty;
+    if (!waitUntil(focused, READY_TIMEOUT_SEC)) {
+      throw new Error(`닫을 탭을 맨 앞으로 가져오지 못했습니다: ${handle.tty}`);
+    }
+    systemEvents.keystroke('w', { using: 'command down' });
+  }
+  delete tabs[handle.tty];
+  delete lastTails[handle.tty];
+  return true;
+}
+
+function captureTabOutput(tab, lineCount) {
+  const lines = tab.contents().split('\n');
+  return lines.slice(Math.max(0, lines.length - lineCount)).join('\n');
+}
+
+// 직전 read 이후 새로 출력된 부분만 { text, gap } 으로 돌려줌 (seed 인 첫 read 는 현재 내용 전체)
+// Terminal 은 출력 스트림을 제공하지 않으므로 매번 내용 전체를 읽어 직전 끝부분 이후를 잘라낸다.
+// 직전 끝부분을 찾을 수 없으면(화면 지우기, 스크롤백 한도 초과, 워커 재시작) 그 사이 출력을 알 수 없으므로
+// 전체 기록을 다시 보내지 않고 gap 으로 알린 뒤 마지막 화면만 보낸다.
+function readNewOutput(tab, tty, seed) {
+  const contents = tab.contents().replace(/\s+$/, '');
+  const tail = lastTails[tty];
+  lastTails[tty] = contents.slice(-TAIL_CHARS);
+  if (tail === '' || (tail === undefined && seed)) {
+    return { text: contents, gap: false };
+  }
+  if (tail !== undefined) {
+    const index = contents.lastIndexOf(tail);
+    if (index !== -1) return { text: contents.slice(index + tail.length), gap: false };
+  }
+  const lines = contents.split('\n');
+  return { text: '\n' + lines.slice(-tab.numberOfRows()).join('\n'), gap: true };
+}
+
+const VERBS = {
+  create: ({ name }) => createNewTab(name),
+  find: ({ name }) => findTabByName(name),
+  list: () => getTabList(),
+  send: ({ handle, text }) => {
+    terminal.doScript(text, { in: tabFor(handle) });
+    return true;
+  },
+  type: ({ handle, text }) => {
+    terminal.doScript(text, { in: tabFor(handle) });
+    return true;
+  },
+  enter: ({ handle }) => {
+    terminal.doScript('', { in: tabFor(handle) }); // Enter 키
+    return true;
+  },
+  close: ({ handle }) => closeTab(handle),
+  capture: ({ handle, lines }) => captureTabOutput(tabFor(handle), lines),
+  read: ({ handle, seed }) => readNewOutput(tabFor(handle), handle.tty, seed)
+};
+
+function respond(response) {
+  const text = $(JSON.stringify(response) + '\n');
+  $.NSFileHandle.fileHandleWithStandardOutput.writeData(text.dataUsingEncoding($.NSUTF8StringEncoding));
+}
+
+// 요청 한 줄 처리. 잘못된 줄(UTF-8·JSON 오류)도 워커를 끝내지 않고 오류 응답으로 돌려준다.
+function handleLine(line) {
+  let id = null;
+  try {
+    if (line === undefined) throw new Error('UTF-8 로 해석할 수 없는 요청입니다');
+    const request = JSON.parse(line);
+    if (!request || typeof request !== 'object') throw new Error('요청은 JSON 객체여야 합니다');
+    id = request.id;
+    const verb = VERBS[request.verb];
+    if (!verb) throw new Error(`알 수 없는 명령어: ${request.verb}`);
+    respond({ id, ok: true, result: verb(request.params || {}) });
+  } catch (error) {
+    respond({ id, ok: false, error: String(error.message || error), code: error.code });
+  }
+}
+
+// 파이프에서 받은 바이트를 그대로 모아 줄바꿈(0x0A) 단위로 자른 뒤 완성된 줄만 디코딩
+// (청크마다 디코딩하면 청크 경계에서 잘린 한글이 nil 이 됨)
+function run() {
+  const input = $.NSFileHandle.fileHandleWithStandardInput;
+  const NEWLINE = $('\n').dataUsingEncoding($.NSUTF8StringEncoding);
+  const pending = $.NSMutableData.data;
+  for (;;) {
+    const data = input.availableData;
+    if (data.length === 0) return; // 데몬 종료
+    pending.appendData(data);
+    for (;;) {
+      const newline = pending.rangeOfDataOptionsRange(NEWLINE, 0, $.NSMakeRange(0, pending.length));
+      if (newline.length === 0) break;
+      const bytes = pending.subdataWithRange($.NSMakeRange(0, newline.location));
+      pending.replaceBytesInRangeWithBytesLength($.NSMakeRange(0, newline.location + 1), null, 0);
+      if (bytes.length === 0) continue;
+      handleLine(ObjC.unwrap($.NSString.alloc.initWithDataEncoding(bytes, $.NSUTF8StringEncoding)));
+    }
+  }
+}
@@ -0,0 +1,240 @@
+// Linux용 tmux 백엔드
+// Terminal.app 탭 하나를 tmux 세션 하나로 대응시킨다 (세션 이름 = 탭 이름).
+// 핸들은 tmux pane id(%N)로, 세션 이름이 바뀌거나 창이 늘어나도 그대로 유지된다.
+// ORCH_TMUX_SOCKET 을 지정하면 별도 tmux 서버(-L)를 사용한다.
+
+import net from 'net';
+import { execFile } from 'child_process';
+import { constants, existsSync, mkdtempSync, openSync, rmSync } from 'fs';
+import { homedir, tmpdir } from 'os';
+import { join } from 'path';
+import { StringDecoder } from 'string_decoder';
+import { handleGone } from './session-registry.mjs';
+
+// CSI, OSC(BEL 또는 ST 종료), 그 밖의 이스케이프 시퀀스 (ESC =, ESC 7, ESC c, 문자 집합 지정 ESC ( B 등).
+// 마지막 형태에서 '[' 와 ']' 는 빼야 청크 끝에서 잘린 CSI·OSC 를 완성된 2바이트 시퀀스로 오인하지 않는다.
+const ESCAPE = /\x1b\[[0-?]*[ -\/]*[@-~]|\x1b\][^\x07\x1b]*(?:\x07|\x1b\\)|\x1b[ -\/]*[0-Z\\^-~]/g;
+const ESCAPE_AT_START = new RegExp(`^(?:${ESCAPE.source})`);
+const MAX_ESCAPE_CHARS = 256;
+const MAX_LINE_CHARS = 4096;
+// 탭·줄바꿈을 뺀 나머지 C0 제어 문자와 DEL
+const CONTROL = /[\x00-\x08\x0b-\x1f\x7f]/g;
+
+// tmux 대상 지정에서 특별한 의미가 있는 문자는 세션 이름에 쓸 수 없음
+export function sessionName(name) {
+  return String(name).replace(/[.:]/g, '_');
+}
+
+// tmux 는 ';' 로 끝나는 인자를 명령 구분자로 보고 떼어 내므로, 끝의 ';' 는 '\;' 로 써야 글자 그대로 전달된다.
+// (tmux 는 끝의 '\;' 를 ';' 하나로 바꾸므로 원래 '\;' 로 끝나는 텍스트도 그대로 남는다)
+export function literalArg(text) {
+  return text.endsWith(';') ? `${text.slice(0, -1)}\\;` : text;
+}
+
+// pipe-pane 으로 받은 원시 출력에서 제어 시퀀스를 걸러 평문만 남김
+// CR 은 줄 맨 앞으로 돌아가 다시 그리는 것이므로 줄마다 마지막 CR 뒤의 내용만 남긴다. 같은 줄의 앞부분을
+// 이전 청크에서 이미 내보냈으면, 다시 그린 내용이 그 뒤로 이어질 때만 늘어난 부분을 붙이고 아니면 새 줄로 내보낸다.
+// 백스페이스는 같은 조각 안의 앞 글자를 지우고, 나머지 제어 문자(BEL 등)는 버린다.
+// 청크 끝에서 잘린 UTF-8 문자나 이스케이프 시퀀스, 청크 끝의 CR 은 다음 청크와 합쳐 처리한다.
+export class PlainText {
+  constructor() {
+    this.decoder = new StringDecoder('utf8');
+    this.carry = '';
+    this.line = ''; // 지금 줄에서 이미 내보낸 내용 (너무 길면 null: 알 수 없음)
+    this.rewind = false; // 직전 청크가 CR 로 끝남
+  }
+
+  push(chunk) {
+    let text = this.carry + this.decoder.write(chunk);
+    this.carry = '';
+    const escape = text.lastIndexOf('\x1b');
+    if (escape !== -1 && text.length - escape < MAX_ESCAPE_CHARS && !ESCAPE_AT_START.test(text.slice(escape))) {
+      this.carry = text.slice(escape);
+      text = text.slice(0, escape);
+    }
+    // CR 로 끝나면 다시 그리는 내용(또는 CRLF 의 LF)이 다음 청크에 있으므로 판단을 미룸
+    text = (this.rewind ? '\r' : '') + text.replace(ESCAPE, '');
+    this.rewind = text.endsWith('\r');
+    let out = '';
+    text.replace(/\r+$/, '').replace(/\r+\n/g, '\n').split('\n').forEach((segment, i) => {
+      if (i > 0) {
+        out += '\n';
+        this.line = '';
+      }
+      out += this.continueLine(segment);
+    });
+    return out;
+  }
+
+  // 줄바꿈 없는 조각을 지금 줄에 이어 적용하고, 새로 내보낼 텍스트를 돌려줌
+  continueLine(segment) {
+    const parts = segment.split('\r');
+    const last = plain(parts[parts.length - 1]);
+    const emitted = this.line;
+    if (parts.length === 1) {
+      this.line = emitted !== null && emitted.length + last.length <= MAX_LINE_CHARS ? emitted + last : null;
+      return last;
+    }
+    this.line = last.length <= MAX_LINE_CHARS ? last : null;
+    if (emitted !== null && last.startsWith(emitted)) return last.slice(emitted.length);
+    return `\n${last}`;
+  }
+}
+
+function plain(text) {
+  return (text.includes('\b') ? applyBackspaces(text) : text).replace(CONTROL, '');
+}
+
+function applyBackspaces(text) {
+  const out = [];
+  for (const char of text) {
+    if (char !== '\b') {
+      out.push(char);
+    } else if (out.length > 0) {
+      out.pop();
+    }
+  }
+  return out.join('');
+}
+
+export class TmuxBackend {
+  constructor({ socket = process.env.ORCH_TMUX_SOCKET, workdir = process.env.ORCH_WORKDIR } = {}) {
+    this.name = 'tmux';
+    this.streaming = true; // pipe-pane 으로 출력을 밀어 줌 (데몬이 폴링하지 않고 출력 도착 시 깨어남)
+    this.prefix = socket ? ['-L', socket] : [];
+    this.workdir = workdir && existsSync(workdir) ? workdir : homedir();
+    this.fifoDir = null;
+  }
+
+  tmux(...args) {
+    return new Promise((resolve, reject) => {
+      execFile('tmux', [...this.prefix, ...args], { maxBuffer: 16 * 1024 * 1024 }, (error, stdout, stderr) => {
+        if (error) {
+          reject(new Error(stderr.trim() || error.message));
+        } else {
+          resolve(stdout);
+        }
+      });
+    });
+  }
+
+  // pane 을 대상으로 하는 명령. 실패했을 때 pane 이 사라졌으면 HANDLE_GONE 으로 알림
+  async target(pane, ...args) {
+    try {
+      return await this.tmux(...args);
+    } catch (error) {
+      if (!(await this.list()).some(tab => tab.id === pane)) {
+        throw handleGone(`pane 이 닫혔습니다: ${pane}`);
+      }
+      throw error;
+    }
+  }
+
+  async create(name) {
+    const session = sessionName(name);
+    const pane = await this.tmux('new-session', '-d', '-s', session, '-c', this.workdir, '-x', '200', '-y', '50',
+      '-P', '-F', '#{pane_id}');
+    return { pane: pane.trim(), session };
+  }
+
+  async find(name) {
+    const session = sessionName(name);
+    try {
+      // display-message 는 없는 대상에도 빈 출력으로 성공하므로 list-panes 로 확인
+      const [pane] = (await this.tmux('list-panes', '-s', '-t', `=${session}`, '-F', '#{pane_id}')).split('\n');
+      return pane ? { pane, session } : null;
+    } catch (error) {
+      return null;
+    }
+  }
+
+  handleId({ pane }) {
+    return pane;
+  }
+
+  // list() 의 title 과 비교할 값 (만들 때의 세션 이름)
+  handleTitle({ session }) {
+    return session;
+  }
+
+  // 살아 있는 모든 pane 을 한 번에 [{ title, id }]
+  async list() {
+    let output;
+    try {
+      output = await this.tmux('list-panes', '-a', '-F', '#{session_name}\t#{pane_id}');
+    } catch (error) {
+      return []; // tmux 서버가 아직 없음
+    }
+    return output.split('\n').filter(Boolean).map(line => {
+      const [title, id] = line.split('\t');
+      return { title, id };
+    });
+  }
+
+  // pane id 로 지정하면 이름이 바뀐 세션도 닫힘
+  async kill({ pane }) {
+    await this.target(pane, 'kill-session', '-t', pane);
+    return true;
+  }
+
+  // 텍스트는 -l 로 글자 그대로 입력하고 Enter 를 따로 보냄 (한 번의 tmux 호출)
+  async send({ pane }, text) {
+    await this.target(pane, 'send-keys', '-t', pane, '-l', '--', literalArg(text), ';', 'send-keys', '-t', pane, 'Enter');
+    return true;
+  }
+
+  // 여러 줄 메시지가 줄마다 제출되지 않도록 bracketed paste 로 붙여넣기 (Enter 는 enter 로 따로)
+  async type({ pane }, text) {
+    const buffer = `orch-${process.pid}-${pane.slice(1)}`;
+    await this.target(pane, 'set-buffer', '-b', buffer, '--', literalArg(text), ';', 'paste-buffer', '-p', '-d', '-b', buffer, '-t', pane);
+    return true;
+  }
+
+  async enter({ pane }) {
+    await this.target(pane, 'send-keys', '-t', pane, 'Enter');
+    return true;
+  }
+
+  async capture({ pane }, lines) {
+    const output = await this.target(pane, 'capture-pane', '-p', '-J', '-t', pane, '-S', `-${lines}`);
+    const all = output.replace(/\n+$/, '').split('\n');
+    return all.slice(Math.max(0, all.length - lines)).join('\n');
+  }
+
+  // pane 출력을 FIFO 로 흘려 받아 sink 로 넘김. 처음에는 지금까지의 화면 내용으로 채운다.
+  // FIFO 를 읽기/쓰기로 열어 두므로 pipe-pane 의 cat 이 재시작돼도 EOF 가 나지 않는다.
+  async watch({ pane }, sink) {
+    this.fifoDir ??= mkdtempSync(join(tmpdir(), 'orch-tmux-'));
+    const fifo = join(this.fifoDir, pane.slice(1));
+    rmSync(fifo, { force: true });
+    await new Promise((resolve, reject) => {
+      execFile('mkfifo', ['-m', '600', fifo], error => (error ? reject(error) : resolve()));
+    });
+    const stream = new net.Socket({ fd: openSync(fifo, constants.O_RDWR | constants.O_NONBLOCK), readable: true, writable: false });
+    const text = new PlainText();
+    stream.on('data', chunk => sink(text.push(chunk)));
+    stream.on('error', () => {});
+
+    try {
+      const history = await this.target(pane, 'capture-pane', '-p', '-J', '-t', pane, '-S', '-');
+      sink(history.replace(/\n+$/, '\n'));
+      await this.target(pane, 'pipe-pane', '-t', pane, `cat > '${fifo}'`);
+    } catch (error) {
+      stream.destroy();
+      rmSync(fifo, { force: true });
+      throw error;
+    }
+    return {
+      poll: async () => {},
+      close: () => {
+        this.tmux('pipe-pane', '-t', pane).catch(() => {});
+        stream.destroy();
+        rmSync(fifo, { force: true });
+      }
+    };
+  }
+
+  close() {
+    if (this.fifoDir) rmSync(this.fifoDir, { recursive: true, force: true });
+  }
+}
@@ -0,0 +1,83 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { execFileSync } from 'child_process';
+import { existsSync, mkdtempSync, readFileSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { PlainText, TmuxBackend, literalArg } from './tmux-backend.mjs';
+
+const hasTmux = (() => {
+  try {
+    execFileSync('tmux', ['-V']);
+    return true;
+  } catch (error) {
+    return false;
+  }
+})();
+
+// 청크를 차례로 넣은 결과를 이어 붙임
+function plain(...chunks) {
+  const text = new PlainText();
+  return chunks.map(chunk => text.push(Buffer.from(chunk))).join('');
+}
+
+test('CSI·OSC·2바이트 이스케이프와 C0 제어 문자를 걸러 냄 (탭·줄바꿈은 유지)', () => {
+  assert.equal(plain('\x1b[1;32mok\x1b[0m\t\x1b]0;제목\x07done\x1b]2;t\x1b\\\x1b=\x07\n'), 'ok\tdone\n');
+  assert.equal(plain('abc\b\bx\x00\x7f\n'), 'ax\n', '백스페이스는 앞 글자를 지움');
+});
+
+test('청크 경계에서 잘린 이스케이프 시퀀스와 UTF-8 문자는 다음 청크와 합침', () => {
+  assert.equal(plain('a\x1b[3', '1mb\x1b', ']0;제', '목\x07c'), 'abc');
+  const bytes = Buffer.from('한글');
+  const text = new PlainText();
+  assert.equal(text.push(bytes.subarray(0, 4)) + text.push(bytes.subarray(4)), '한글');
+});
+
+test('CR 로 다시 그린 줄은 마지막 내용만 남김', () => {
+  assert.equal(plain('a 10%\ra 20%\ra 30%\n'), 'a 30%\n');
+  assert.equal(plain('x\r', '\ny'), 'x\ny', '청크 끝의 CR 과 다음 청크의 LF 는 CRLF');
+  assert.equal(plain('x\r\r\ny'), 'x\ny');
+});
+
+test('이전 청크에서 내보낸 줄을 다시 그리면 늘어난 부분만 붙이고, 다르면 새 줄로', () => {
+  assert.equal(plain('root@vm:~# echo 안녕 하세요', '\r\x1b[Kroot@vm:~# echo 안녕 하세요\r\n안녕 하세요\r\n'),
+    'root@vm:~# echo 안녕 하세요\n안녕 하세요\n');
+  assert.equal(plain('$ ec', '\r$ echo hi'), '$ echo hi');
+  assert.equal(plain('$ ab', 'c\b \b', '\r$ abd'), '$ abd', '지웠다가 다시 그림');
+  assert.equal(plain('a 10%', '\ra 20%'), 'a 10%\na 20%');
+});
+
+test('끝의 ; 만 \\; 로 바꿈', () => {
+  assert.equal(literalArg('echo one; echo two'), 'echo one; echo two');
+  assert.equal(literalArg('echo typed;'), 'echo typed\\;');
+  assert.equal(literalArg(';'), '\\;');
+  assert.equal(literalArg('a\\;'), 'a\\\\;');
+});
+
+// 입력을 그대로 파일에 적는 pane 을 별도 tmux 서버에 띄워, tmux 가 실제로 넘겨준 글자를 확인
+test('send·type 은 ; 로 끝나는 텍스트도 글자 그대로 전달', { skip: !hasTmux && 'tmux 없음' }, async t => {
+  const dir = mkdtempSync(join(tmpdir(), 'orch-tmux-test-'));
+  const backend = new TmuxBackend({ socket: `orch-test-${process.pid}`, workdir: dir });
+  t.after(async () => {
+    await backend.tmux('kill-server').catch(() => {});
+    backend.close();
+    rmSync(dir, { recursive: true, force: true });
+  });
+  const out = join(dir, 'received');
+  const pane = (await backend.tmux('new-session', '-d', '-s', 'echo', '-P', '-F', '#{pane_id}', `stty -echo; cat > '${out}'`)).trim();
+  const handle = { pane, session: 'echo' };
+  const expected = 'echo one; echo two;\n;\n안녕\\;\necho typed;\n';
+
+  await backend.send(handle, 'echo one; echo two;');
+  await backend.send(handle, ';');
+  await backend.send(handle, '안녕\\;');
+  await backend.type(handle, 'echo typed;');
+  await backend.enter(handle);
+
+  let received = '';
+  for (let i = 0; i < 100 && received !== expected; i++) {
+    await new Promise(resolve => setTimeout(resolve, 20));
+    received = existsSync(out) ? readFileSync(out, 'utf8') : '';
+  }
+  assert.equal(received, expected);
+});
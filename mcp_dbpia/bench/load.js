@@ -0,0 +1,156 @@
+#!/usr/bin/env node
+// mcp_dbpia stdio 부하 생성기
+// 로컬 대역 서버를 띄우고 index.js 를 자식 프로세스로 실행하여 JSON-RPC 요청을 보낸 뒤
+// 시나리오별 처리량과 p50/p95/p99 지연 시간을 출력한다.
+//
+// 사용법: node bench/load.js [--scenario all|cold|warm|concurrent] [--requests 200]
+//                             [--concurrency 16] [--latency 50] [--docs 0] [--limit 10] [--rate 1000]
+//   --rate 는 서버의 DBPIA_RATE_LIMIT (기본값은 할당량 제한 없이 서버 자체 성능을 측정하도록 크게 설정)
+
+import { spawn } from 'child_process';
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { dirname, join } from 'path';
+import { fileURLToPath } from 'url';
+import { createInterface } from 'readline';
+import { startStubServer, parseArgs } from './stub-server.js';
+
+const SERVER = join(dirname(fileURLToPath(import.meta.url)), '..', 'index.js');
+
+export class McpClient {
+  constructor(env = {}) {
+    this.nextId = 1;
+    this.pending = new Map();
+    this.child = spawn(process.execPath, [SERVER], {
+      env: { ...process.env, DBPIA_API_KEY: 'bench', ...env },
+      stdio: ['pipe', 'pipe', 'inherit']
+    });
+    this.exited = new Promise(resolve => this.child.once('exit', resolve));
+    createInterface({ input: this.child.stdout }).on('line', line => {
+      const message = JSON.parse(line);
+      const entry = this.pending.get(message.id);
+      if (!entry) return;
+      this.pending.delete(message.id);
+      entry.resolve({ response: message, ms: performance.now() - entry.start });
+    });
+  }
+
+  request(method, params) {
+    const id = this.nextId++;
+    return new Promise(resolve => {
+      this.pending.set(id, { resolve, start: performance.now() });
+      this.child.stdin.write(JSON.stringify({ jsonrpc: "2.0", id, method, params }) + '\n');
+    });
+  }
+
+  search(query, limit) {
+    return this.request("tools/call", { name: "search_dbpia", arguments: { query, limit } });
+  }
+
+  async close() {
+    this.child.stdin.end();
+    await this.exited;
+  }
+}
+
+export function percentile(sorted, p) {
+  if (sorted.length === 0) return 0;
+  const rank = Math.ceil((p / 100) * sorted.length) - 1;
+  return sorted[Math.min(sorted.length - 1, Math.max(0, rank))];
+}
+
+// 최대 concurrency 개의 요청을 유지하며 queries 를 순서대로 보냄
+async function drive(client, queries, concurrency, limit) {
+  const latencies = [];
+  let errors = 0;
+  let next = 0;
+  const start = performance.now();
+  const worker = async () => {
+    while (next < queries.length) {
+      const { response, ms } = await client.search(queries[next++], limit);
+      if (response.error) errors++;
+      latencies.push(ms);
+    }
+  };
+  await Promise.all(Array.from({ length: Math.min(concurrency, queries.length) }, worker));
+  const elapsed = performance.now() - start;
+  latencies.sort((a, b) => a - b);
+  return {
+    requests: queries.length,
+    errors,
+    throughput: queries.length / (elapsed / 1000),
+    p50: percentile(latencies, 50),
+    p95: percentile(latencies, 95),
+    p99: percentile(latencies, 99),
+    max: latencies[latencies.length - 1] || 0
+  };
+}
+
+const SCENARIOS = {
+  // 매 요청이 새로운 검색어, 순차 실행
+  cold: async (client, options) =>
+    drive(client, Array.from({ length: options.requests }, (_, i) => `cold query ${i}`), 1, options.limit),
+
+  // 소수의 검색어로 캐시를 채운 뒤 반복 조회
+  warm: async (client, options) => {
+    const keys = Array.from({ length: 10 }, (_, i) => `warm query ${i}`);
+    await drive(client, keys, keys.length, options.limit);
+    return drive(client, Array.from({ length: options.requests }, (_, i) => keys[i % keys.length]), 1, options.limit);
+  },
+
+  // 새로운 검색어를 concurrency 개씩 동시에 실행
+  concurrent: async (client, options) =>
+    drive(client, Array.from({ length: options.requests }, (_, i) => `concurrent query ${i}`),
+      options.concurrency, options.limit)
+};
+
+async function runScenario(name, options) {
+  const stub = await startStubServer({ port: 0, latencyMs: options.latency, docs: options.docs });
+  const cacheDir = mkdtempSync(join(tmpdir(), 'mcp-dbpia-bench-'));
+  const client = new McpClient({
+    DBPIA_API_URL: stub.url,
+    DBPIA_CACHE_DIR: cacheDir,
+    DBPIA_MAX_CONCURRENCY: String(Math.max(options.concurrency, 8)),
+    DBPIA_RATE_LIMIT: String(options.rate)
+  });
+  try {
+    await client.request("initialize", {});
+    const result = await SCENARIOS[name](client, options);
+    return { scenario: name, ...result, upstream: stub.stats.requests };
+  } finally {
+    await client.close();
+    await stub.close();
+    rmSync(cacheDir, { recursive: true, force: true });
+  }
+}
+
+function printReport(rows) {
+  const header = ['scenario', 'requests', 'errors', 'req/s', 'p50 ms', 'p95 ms', 'p99 ms', 'max ms', 'upstream'];
+  const lines = rows.map(r => [
+    r.scenario, r.requests, r.errors, r.throughput.toFixed(1),
+    r.p50.toFixed(1), r.p95.toFixed(1), r.p99.toFixed(1), r.max.toFixed(1), r.upstream
+  ].map(String));
+  const widths = header.map((h, i) => Math.max(h.length, ...lines.map(l => l[i].length)));
+  const format = cells => cells.map((c, i) => c.padStart(widths[i])).join('  ');
+  console.log(format(header));
+  lines.forEach(l => console.log(format(l)));
+}
+
+if (import.meta.url === `file://${process.argv[1]}`) {
+  const options = parseArgs(process.argv.slice(2), {
+    scenario: 'all', requests: 200, concurrency: 16, latency: 50, docs: 0, limit: 10, rate: 1000
+  });
+  const names = options.scenario === 'all' ? Object.keys(SCENARIOS) : [options.scenario];
+  for (const name of names) {
+    if (!SCENARIOS[name]) {
+      console.error(`알 수 없는 시나리오: ${name} (${Object.keys(SCENARIOS).join(', ')})`);
+      process.exit(1);
+    }
+  }
+  console.log(`대역 서버 지연 ${options.latency}ms, 요청 ${options.requests}개, 동시 ${options.concurrency}, limit ${options.limit}\n`);
+  const rows = [];
+  for (const name of names) {
+    rows.push(await runScenario(name, options));
+  }
+  printReport(rows);
+}
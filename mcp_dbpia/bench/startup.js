@@ -0,0 +1,79 @@
+#!/usr/bin/env node
+// mcp_dbpia 기동 시간 측정
+// index.js 를 runs 번 새로 띄워 프로세스 생성부터 initialize 응답·tools/list 응답까지의 시간과
+// 첫 검색(지연 로딩되는 모듈 포함) 응답 시간을 잰다. 빈 node 프로세스가 첫 줄에 응답하는
+// 시간을 기준선으로 함께 출력하고, initialize p95 가 --budget(ms)을 넘으면 종료 코드 1.
+//
+// 사용법: node bench/startup.js [--runs 20] [--budget 150]
+
+import { spawn } from 'child_process';
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { createInterface } from 'readline';
+import { McpClient, percentile } from './load.js';
+import { startStubServer, parseArgs } from './stub-server.js';
+
+// 런타임 자체의 기동 시간: stdin 첫 줄을 받으면 바로 응답하는 빈 프로세스
+function baseline() {
+  const start = performance.now();
+  const child = spawn(process.execPath, ['-e',
+    "require('readline').createInterface({ input: process.stdin }).once('line', l => { console.log(l); process.exit(0); })"
+  ], { stdio: ['pipe', 'pipe', 'inherit'] });
+  child.stdin.write('{}\n');
+  return new Promise(resolve => {
+    createInterface({ input: child.stdout }).once('line', () => resolve(performance.now() - start));
+  });
+}
+
+async function measure(stubUrl) {
+  const cacheDir = mkdtempSync(join(tmpdir(), 'mcp-dbpia-startup-'));
+  const start = performance.now();
+  const client = new McpClient({ DBPIA_API_URL: stubUrl, DBPIA_CACHE_DIR: cacheDir });
+  try {
+    const initialize = client.request("initialize", {}).then(() => performance.now() - start);
+    const toolsList = client.request("tools/list", {}).then(() => performance.now() - start);
+    const [initializeMs, toolsListMs] = await Promise.all([initialize, toolsList]);
+    const { ms: firstSearchMs } = await client.search('startup', 10);
+    const { ms: secondSearchMs } = await client.search('startup 2', 10);
+    return { initializeMs, toolsListMs, firstSearchMs, secondSearchMs };
+  } finally {
+    await client.close();
+    rmSync(cacheDir, { recursive: true, force: true });
+  }
+}
+
+function summarize(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return `p50 ${percentile(sorted, 50).toFixed(1)}  p95 ${percentile(sorted, 95).toFixed(1)}  max ${sorted[sorted.length - 1].toFixed(1)}`;
+}
+
+if (import.meta.url === `file://${process.argv[1]}`) {
+  const options = parseArgs(process.argv.slice(2), { runs: 20, budget: 150 });
+  const stub = await startStubServer({ port: 0, latencyMs: 0, docs: 0 });
+  const rows = [];
+  const baselines = [];
+  try {
+    for (let i = 0; i < options.runs; i++) {
+      baselines.push(await baseline());
+      rows.push(await measure(stub.url));
+    }
+  } finally {
+    await stub.close();
+  }
+
+  const initialize = rows.map(r => r.initializeMs);
+  console.log(`실행 ${options.runs}회 (ms)`);
+  console.log(`  node 기준선       ${summarize(baselines)}`);
+  console.log(`  initialize 응답   ${summarize(initialize)}`);
+  console.log(`  tools/list 응답   ${summarize(rows.map(r => r.toolsListMs))}`);
+  console.log(`  첫 검색           ${summarize(rows.map(r => r.firstSearchMs))}`);
+  console.log(`  두 번째 검색      ${summarize(rows.map(r => r.secondSearchMs))}`);
+
+  const p95 = percentile([...initialize].sort((a, b) => a - b), 95);
+  if (p95 > options.budget) {
+    console.error(`\ninitialize p95 ${p95.toFixed(1)}ms 가 예산 ${options.budget}ms 를 초과했습니다`);
+    process.exit(1);
+  }
+  console.log(`\ninitialize p95 ${p95.toFixed(1)}ms (예산 ${options.budget}ms 이내)`);
+}
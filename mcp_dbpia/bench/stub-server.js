@@ -0,0 +1,99 @@
+#!/usr/bin/env node
+// DBpia 검색 API 로컬 대역 서버 (벤치마크용)
+// fixtures/search.xml 의 document 를 반복하여 요청한 수만큼 응답하고,
+// 지연 시간과 문서 수를 조절할 수 있다.
+//
+// 사용법: node bench/stub-server.js [--port 8765] [--latency 50] [--jitter 0] [--docs 0]
+//   --docs 0 이면 요청의 countall/pagecount 만큼 문서를 돌려준다.
+
+import http from 'http';
+import { readFileSync } from 'fs';
+import { fileURLToPath } from 'url';
+import { dirname, join } from 'path';
+
+const FIXTURE = join(dirname(fileURLToPath(import.meta.url)), 'fixtures', 'search.xml');
+
+function loadTemplates(path) {
+  const xml = readFileSync(path, 'utf8');
+  const documents = xml.match(/<document>[\s\S]*?<\/document>/g) || [];
+  if (documents.length === 0) {
+    throw new Error(`No <document> elements in ${path}`);
+  }
+  return documents;
+}
+
+function escapeXml(text) {
+  return text.replace(/[<>&]/g, c => ({ '<': '&lt;', '>': '&gt;', '&': '&amp;' })[c]);
+}
+
+// 검색어·페이지·순번마다 고유한 tid 를 갖도록 템플릿을 변형
+function renderPage(templates, query, page, count) {
+  const seed = [...query].reduce((hash, c) => (hash * 31 + c.codePointAt(0)) % 1000000, 7);
+  const documents = [];
+  for (let i = 0; i < count; i++) {
+    const index = (page - 1) * count + i;
+    const template = templates[index % templates.length];
+    documents.push(template
+      .replace(/<tid>[^<]*<\/tid>/, `<tid>NODE${seed}${String(index).padStart(5, '0')}</tid>`)
+      .replace(/<titl><!\[CDATA\[/, `<titl><![CDATA[[${escapeXml(query)} #${index + 1}] `));
+  }
+  return `<?xml version="1.0" encoding="UTF-8"?>\n<root><result><totalcount>${count * 100}</totalcount></result>` +
+    `<response><documents>${documents.join('')}</documents></response></root>`;
+}
+
+export function startStubServer({ port = 8765, latencyMs = 50, jitterMs = 0, docs = 0, fixture = FIXTURE } = {}) {
+  const templates = loadTemplates(fixture);
+  const stats = { requests: 0 };
+  const server = http.createServer((req, res) => {
+    stats.requests++;
+    const url = new URL(req.url, 'http://localhost');
+    const query = url.searchParams.get('searchall') || '';
+    const page = parseInt(url.searchParams.get('pagenumber'), 10) || 1;
+    const count = docs || parseInt(url.searchParams.get('pagecount') || url.searchParams.get('countall'), 10) || 10;
+    const body = renderPage(templates, query, page, count);
+    const delay = latencyMs + Math.random() * jitterMs;
+    setTimeout(() => {
+      res.writeHead(200, { 'Content-Type': 'text/xml; charset=utf-8' });
+      res.end(body);
+    }, delay);
+  });
+
+  return new Promise((resolve, reject) => {
+    server.once('error', reject);
+    server.listen(port, '127.0.0.1', () => {
+      resolve({
+        server,
+        stats,
+        url: `http://127.0.0.1:${server.address().port}/v2/search/search.xml`,
+        close: () => new Promise(done => {
+          server.closeAllConnections?.();
+          server.close(done);
+        })
+      });
+    });
+  });
+}
+
+export function parseArgs(argv, defaults) {
+  const options = { ...defaults };
+  for (let i = 0; i < argv.length; i++) {
+    const match = argv[i].match(/^--([\w-]+)$/);
+    if (!match) continue;
+    const key = match[1].replace(/-(\w)/g, (_, c) => c.toUpperCase());
+    const value = argv[i + 1];
+    options[key] = typeof defaults[key] === 'number' ? Number(value) : value;
+    i++;
+  }
+  return options;
+}
+
+if (import.meta.url === `file://${process.argv[1]}`) {
+  const options = parseArgs(process.argv.slice(2), { port: 8765, latency: 50, jitter: 0, docs: 0 });
+  const stub = await startStubServer({
+    port: options.port,
+    latencyMs: options.latency,
+    jitterMs: options.jitter,
+    docs: options.docs
+  });
+  console.log(`DBpia 대역 서버 실행 중: ${stub.url} (지연 ${options.latency}ms, 문서 수 ${options.docs || '요청값'})`);
+}
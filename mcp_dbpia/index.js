@@ -1,15 +1,102 @@
 #!/usr/bin/env node
-import fetch from 'node-fetch';
-import { parseStringPromise } from 'xml2js';
-import { createReadStream } from 'fs';
-import { createInterface } from 'readline';
+import { homedir } from 'os';
+import { join } from 'path';
+import { RequestDispatcher } from './lib/dispatcher.js';
+import { JsonRpcFramer } from './lib/framer.js';
+import { ResultCache, searchCacheKey } from './lib/cache.js';
+import { HttpClient } from './lib/http.js';
+import { UpstreamGuard } from './lib/ratelimit.js';
+import { parseDocuments } from './lib/parser.js';
+import { SingleFlight } from './lib/singleflight.js';
+import { mapSettled } from './lib/concurrency.js';
+import { LocalIndex } from './lib/local-index.js';
+import { Prefetcher } from './lib/prefetch.js';
+import { Metrics, MetricsFileWriter } from './lib/metrics.js';
+import { throwIfCancelled } from './lib/cancel.js';
+import { ResponseWriter } from './lib/writer.js';
+import { QueryCanonicalizer } from './lib/canonical.js';
+import { DuplicateIndex } from './lib/dedup.js';
+import { OUTPUT_PROPERTIES, DETAIL_OUTPUT, InvalidParamsError, parseOutputOptions, projectItem, formatItem, formatItems, toolResult } from './lib/format.js';
 
-class DBpiaSearchMCP {
+const DEFAULT_API_URL = 'http://api.dbpia.co.kr/v2/search/search.xml';
+const MAX_PAGE_SIZE = 100;
+const MAX_PAGES_PER_CALL = 10;
+const MAX_BATCH_QUERIES = 50;
+const MAX_DOCUMENTS_PER_CALL = 20;
+const DEDUP_SEED_CHUNK = 200;
+
+function envNumber(name, fallback) {
+  const value = Number(process.env[name]);
+  return process.env[name] && Number.isFinite(value) ? value : fallback;
+}
+
+function parseCursor(cursor) {
+  if (cursor === undefined || cursor === null || cursor === '') {
+    return 1;
+  }
+  const page = parseInt(cursor, 10);
+  if (!Number.isInteger(page) || page < 1 || String(page) !== String(cursor)) {
+    throw new InvalidParamsError(`Invalid cursor: ${cursor}`);
+  }
+  return page;
+}
+
+export class DBpiaSearchMCP {
   constructor() {
     this.apiKey = process.env.DBPIA_API_KEY;
     if (!this.apiKey) {
       throw new Error('DBPIA_API_KEY environment variable is required');
     }
+    const cacheDir = process.env.DBPIA_CACHE_DIR ?? join(homedir(), '.cache', 'mcp_dbpia');
+    this.cache = new ResultCache({
+      maxEntries: envNumber('DBPIA_CACHE_SIZE', 500),
+      ttlMs: envNumber('DBPIA_CACHE_TTL', 24 * 60 * 60) * 1000,
+      dir: cacheDir,
+      maxBytes: envNumber('DBPIA_CACHE_MAX_BYTES', 64 * 1024 * 1024)
+    });
+    // 결과가 없는 페이지(원격의 일시적 오류·할당량 초과 응답이 빈 목록으로 파싱된 경우 포함)는 짧게만 캐시
+    this.emptyTtlMs = envNumber('DBPIA_EMPTY_CACHE_TTL', 60) * 1000;
+    this.documentCache = new ResultCache({
+      maxEntries: envNumber('DBPIA_DOCUMENT_CACHE_SIZE', 1000),
+      ttlMs: envNumber('DBPIA_CACHE_TTL', 24 * 60 * 60) * 1000,
+      dir: cacheDir ? join(cacheDir, 'documents') : null,
+      maxBytes: envNumber('DBPIA_CACHE_MAX_BYTES', 64 * 1024 * 1024)
+    });
+    this.localIndex = new LocalIndex({
+      path: process.env.DBPIA_INDEX_PATH || (cacheDir ? join(cacheDir, 'local-index.json') : null)
+    });
+    this.notify = () => {};
+    this.dispatcher = null;
+    this.writer = null;
+    this.metrics = new Metrics();
+    this.metricsWriter = process.env.DBPIA_METRICS_FILE
+      ? new MetricsFileWriter({
+        path: process.env.DBPIA_METRICS_FILE,
+        intervalMs: envNumber('DBPIA_METRICS_INTERVAL', 60) * 1000,
+        collect: () => this.stats()
+      })
+      : null;
+    this.flights = new SingleFlight();
+    this.canonicalizer = QueryCanonicalizer.fromFile(process.env.DBPIA_QUERY_SYNONYMS);
+    this.duplicates = new DuplicateIndex({ threshold: envNumber('DBPIA_DEDUP_THRESHOLD', 0.7) });
+    this.duplicatesReady = null;
+    this.batchConcurrency = envNumber('DBPIA_BATCH_CONCURRENCY', 4);
+    this.apiUrl = process.env.DBPIA_API_URL || DEFAULT_API_URL;
+    this.http = new HttpClient({
+      maxSockets: envNumber('DBPIA_MAX_SOCKETS', 16),
+      timeoutMs: envNumber('DBPIA_TIMEOUT_MS', 10000)
+    });
+    this.guard = new UpstreamGuard({
+      ratePerSec: envNumber('DBPIA_RATE_LIMIT', 10),
+      burst: envNumber('DBPIA_RATE_BURST', undefined),
+      maxRetries: envNumber('DBPIA_MAX_RETRIES', 3),
+      failureThreshold: envNumber('DBPIA_BREAKER_THRESHOLD', 5),
+      cooldownMs: envNumber('DBPIA_BREAKER_COOLDOWN', 30) * 1000
+    });
+    this.prefetcher = new Prefetcher({
+      enabled: process.env.DBPIA_PREFETCH === '1',
+      hasCapacity: () => this.guard.hasSpareCapacity(envNumber('DBPIA_PREFETCH_RESERVE', 2))
+    });
   }
 
   async initialize() {
@@ -50,64 +137,306 @@ class DBpiaSearchMCP {
                   type: "number",
                   description: "검색 결과 수 제한 (기본값: 10)",
                   default: 10
-                }
+                },
+                ...OUTPUT_PROPERTIES
+              },
+              required: ["query"]
+            }
+          },
+          {
+            name: "search_dbpia_paged",
+            description: "DBpia 검색 결과를 페이지 단위로 가져옵니다. progressive 모드에서는 페이지가 도착할 때마다 진행 알림으로 부분 결과를 보냅니다",
+            inputSchema: {
+              type: "object",
+              properties: {
+                query: {
+                  type: "string",
+                  description: "검색할 키워드"
+                },
+                page_size: {
+                  type: "number",
+                  description: `페이지당 결과 수 (기본값: 10, 최대: ${MAX_PAGE_SIZE})`,
+                  default: 10
+                },
+                cursor: {
+                  type: "string",
+                  description: "이전 응답의 nextCursor 값 (생략하면 첫 페이지)"
+                },
+                pages: {
+                  type: "number",
+                  description: `한 번에 가져올 페이지 수 (기본값: 1, 최대: ${MAX_PAGES_PER_CALL})`,
+                  default: 1
+                },
+                progressive: {
+                  type: "boolean",
+                  description: "true이면 각 페이지 도착 시 notifications/progress로 부분 결과 전송 (progressToken 필요)",
+                  default: false
+                },
+                ...OUTPUT_PROPERTIES
+              },
+              required: ["query"]
+            }
+          },
+          {
+            name: "search_local",
+            description: "지금까지 DBpia에서 가져온 논문의 로컬 색인을 BM25로 검색합니다 (네트워크 사용 안 함)",
+            inputSchema: {
+              type: "object",
+              properties: {
+                query: {
+                  type: "string",
+                  description: "검색할 키워드"
+                },
+                limit: {
+                  type: "number",
+                  description: "검색 결과 수 제한 (기본값: 10)",
+                  default: 10
+                },
+                ...OUTPUT_PROPERTIES
               },
               required: ["query"]
             }
+          },
+          {
+            name: "get_dbpia_document",
+            description: "검색 결과의 tid로 논문 상세 정보(전체 초록 포함)를 조회합니다. 여러 tid를 한 번에 조회할 수 있습니다",
+            inputSchema: {
+              type: "object",
+              properties: {
+                tid: {
+                  type: "string",
+                  description: "조회할 논문 tid"
+                },
+                tids: {
+                  type: "array",
+                  items: { type: "string" },
+                  description: `여러 논문을 한 번에 조회할 tid 목록 (최대 ${MAX_DOCUMENTS_PER_CALL}개)`
+                },
+                ...OUTPUT_PROPERTIES
+              }
+            }
+          },
+          {
+            name: "server_stats",
+            description: "서버 성능 지표(단계별 지연 시간 히스토그램, 캐시·속도 제한·연결 재사용 통계)를 조회합니다",
+            inputSchema: {
+              type: "object",
+              properties: {}
+            }
+          },
+          {
+            name: "search_dbpia_batch",
+            description: "여러 키워드를 한 번에 병렬 검색하고 결과를 논문(tid) 단위로 병합·중복 제거합니다",
+            inputSchema: {
+              type: "object",
+              properties: {
+                queries: {
+                  type: "array",
+                  items: { type: "string" },
+                  description: `검색할 키워드 목록 (최대 ${MAX_BATCH_QUERIES}개)`
+                },
+                limit: {
+                  type: "number",
+                  description: "키워드별 검색 결과 수 제한 (기본값: 10)",
+                  default: 10
+                },
+                ...OUTPUT_PROPERTIES
+              },
+              required: ["queries"]
+            }
           }
         ]
       }
     };
   }
 
-  async callTool(name, arguments_) {
+  async callTool(name, arguments_, context = {}) {
+    const output = parseOutputOptions(arguments_, name === "get_dbpia_document" ? DETAIL_OUTPUT : undefined);
+    const { signal } = context;
     if (name === "search_dbpia") {
-      return await this.searchDBpia(arguments_.query, arguments_.limit || 10);
+      return await this.searchDBpia(arguments_.query, arguments_.limit || 10, output, signal);
+    }
+    if (name === "search_dbpia_paged") {
+      return await this.searchDBpiaPaged(arguments_, output, context);
+    }
+    if (name === "search_local") {
+      return await this.searchLocal(arguments_.query, arguments_.limit || 10, output);
+    }
+    if (name === "get_dbpia_document") {
+      const tids = [...(arguments_.tid ? [arguments_.tid] : []), ...(arguments_.tids || [])];
+      return await this.getDocuments(tids, output, signal);
+    }
+    if (name === "server_stats") {
+      return {
+        jsonrpc: "2.0",
+        id: null,
+        result: toolResult({ format: 'json' }, null, this.stats())
+      };
+    }
+    if (name === "search_dbpia_batch") {
+      return await this.searchDBpiaBatch(arguments_.queries, arguments_.limit || 10, output, signal);
     }
     throw new Error(`Unknown tool: ${name}`);
   }
 
-  async searchDBpia(query, limit = 10) {
-    try {
-      const encodedQuery = encodeURIComponent(query);
-      const url = `http://api.dbpia.co.kr/v2/search/search.xml?key=${this.apiKey}&searchall=${encodedQuery}&countall=${limit}`;
-      
-      const response = await fetch(url);
-      const xml = await response.text();
-      const js = await parseStringPromise(xml);
-      
-      const docs = js.response?.documents?.[0]?.document || [];
-      
-      const items = docs.map(d => ({
-        title: d.titl ? d.titl[0] : '',
-        authors: d.auth ? d.auth[0] : '',
-        journal: d.pbls ? d.pbls[0] : '',
-        url: d.tid ? `http://www.dbpia.co.kr/Search/JournalDetail?zid=${d.tid[0]}` : '',
-        abstract: d.abst ? d.abst[0] : '',
-        year: d.year ? d.year[0] : '',
-        publisher: d.publ ? d.publ[0] : ''
-      }));
+  async fetchDocuments(query, limit, page = 1, signal) {
+    const encodedQuery = encodeURIComponent(query);
+    let url = `${this.apiUrl}?key=${this.apiKey}&searchall=${encodedQuery}&countall=${limit}`;
+    if (page > 1) {
+      url += `&pagecount=${limit}&pagenumber=${page}`;
+    }
+    
+    const docs = await this.guard.run(async () => {
+      const timing = {};
+      const parsed = await this.http.get(url, response => parseDocuments(response.body, limit, timing), { timing, signal });
+      this.metrics.observe('upstream_ttfb', timing.ttfbMs);
+      this.metrics.observe('body_download', timing.bodyMs - timing.parseMs);
+      this.metrics.observe('parse', timing.parseMs);
+      return parsed;
+    }, signal);
+    
+    return docs.map(d => ({
+      title: d.titl || '',
+      authors: d.auth || '',
+      journal: d.pbls || '',
+      tid: d.tid || '',
+      url: d.tid ? `http://www.dbpia.co.kr/Search/JournalDetail?zid=${d.tid}` : '',
+      abstract: d.abst || '',
+      year: d.year || '',
+      publisher: d.publ || ''
+    }));
+  }
+
+  // 캐시 조회와 원격 호출을 키 단위로 병합하여 동시에 들어온 같은 검색은 한 번만 수행
+  // (원격 호출은 기다리는 호출자가 모두 취소했을 때만 중단)
+  // 키는 정규형이므로 표기만 다른 검색은 같은 결과를 공유하고, 원격에는 사용자가 입력한 검색어를 보낸다.
+  loadDocuments(query, limit, page = 1, { prefetch = false, signal } = {}) {
+    const cacheKey = searchCacheKey(this.canonicalizer.canonicalize(query), limit, page);
+    if (!prefetch) {
+      this.prefetcher.consume(cacheKey);
+    }
+    return this.flights.run(cacheKey, async (sharedSignal) => {
+      let items = await this.cache.get(cacheKey);
+      if (!items) {
+        items = await this.fetchDocuments(query, limit, page, sharedSignal);
+        await this.cache.set(cacheKey, items, items.length === 0 ? this.emptyTtlMs : undefined);
+        await this.localIndex.add(items);
+      }
+      return items;
+    }, signal);
+  }
+
+  // 가득 찬 페이지를 돌려준 뒤 다음 페이지를 백그라운드로 받아 캐시에 넣어 둠
+  prefetchNext(query, limit, page, items) {
+    if (items.length < limit) return;
+    const nextKey = searchCacheKey(this.canonicalizer.canonicalize(query), limit, page + 1);
+    if (this.cache.has(nextKey)) return;
+    this.prefetcher.schedule(nextKey,
+      () => this.loadDocuments(query, limit, page + 1, { prefetch: true }));
+  }
+
+  // tid 단위 조회: 문서 캐시 → 로컬 색인(검색 때 받아 둔 전체 레코드) → DBpia 원격 조회 순
+  loadDocument(tid, signal) {
+    return this.flights.run(`document:${tid}`, async (sharedSignal) => {
+      let record = await this.documentCache.get(tid);
+      if (record) {
+        return record;
+      }
+      record = await this.localIndex.get(tid);
+      if (!record) {
+        const items = await this.fetchDocuments(tid, 10, 1, sharedSignal);
+        record = items.find(item => item.tid === tid) || null;
+        if (record) {
+          await this.localIndex.add([record]);
+        }
+      }
+      if (record) {
+        await this.documentCache.set(tid, record);
+      }
+      return record;
+    }, signal);
+  }
 
+  // 근사 중복 묶기: 처음 쓸 때 로컬 색인에 축적된 논문으로 서명 색인을 채워
+  // 이전 검색·세션에서 본 판본과도 같은 대표 tid 로 묶이게 함
+  // (색인이 커도 다른 요청이 멈추지 않도록 DEDUP_SEED_CHUNK 건마다 이벤트 루프에 양보)
+  async clusterItems(items) {
+    this.duplicatesReady ??= this.localIndex.load().then(async () => {
+      let added = 0;
+      for (const record of this.localIndex.records.values()) {
+        this.duplicates.add(record);
+        if (++added % DEDUP_SEED_CHUNK === 0) {
+          await new Promise(resolve => setImmediate(resolve));
+        }
+      }
+    });
+    await this.duplicatesReady;
+    return this.metrics.time('dedup', () => this.duplicates.group(items));
+  }
+
+  async getDocuments(tids, output = parseOutputOptions({}, DETAIL_OUTPUT), signal) {
+    const unique = [...new Set(tids.map(tid => String(tid).trim()).filter(Boolean))];
+    if (unique.length === 0) {
+      throw new InvalidParamsError('tid or tids is required');
+    }
+    if (unique.length > MAX_DOCUMENTS_PER_CALL) {
+      throw new InvalidParamsError(`Too many tids: ${unique.length} (max ${MAX_DOCUMENTS_PER_CALL})`);
+    }
+
+    const results = await mapSettled(unique, this.batchConcurrency, tid => this.loadDocument(tid, signal));
+    throwIfCancelled(signal);
+    const documents = [];
+    const missing = [];
+    results.forEach((result, index) => {
+      if (result.status === 'fulfilled' && result.value) {
+        documents.push(result.value);
+      } else {
+        missing.push({ tid: unique[index], error: result.reason?.message || '찾을 수 없음' });
+      }
+    });
+
+    if (documents.length === 0 && missing.some(entry => entry.error !== '찾을 수 없음')) {
       return {
         jsonrpc: "2.0",
         id: null,
-        result: {
-          content: [
-            {
-              type: "text",
-              text: `DBpia 검색 결과 (키워드: "${query}"):\n\n${items.map((item, index) => 
-                `${index + 1}. **${item.title}**\n` +
-                `   저자: ${item.authors}\n` +
-                `   학술지: ${item.journal}\n` +
-                `   출판년도: ${item.year}\n` +
-                `   출판사: ${item.publisher}\n` +
-                `   URL: ${item.url}\n` +
-                `   초록: ${item.abstract.substring(0, 200)}${item.abstract.length > 200 ? '...' : ''}\n`
-              ).join('\n')}`
-            }
-          ]
+        error: {
+          code: -32603,
+          message: `DBpia 문서 조회 중 오류 발생: ${missing[0].error}`
         }
       };
+    }
+
+    return {
+      jsonrpc: "2.0",
+      id: null,
+      result: this.metrics.time('format', () => {
+        let text = `DBpia 논문 상세 (${documents.length}/${unique.length}건):\n\n${formatItems(documents, 0, output)}`;
+        if (missing.length > 0) {
+          text += `\n${missing.map(entry => `⚠️ ${entry.tid}: ${entry.error}`).join('\n')}\n`;
+        }
+        return toolResult(output, text, {
+          documents: documents.map(document => projectItem(document, output)),
+          missing
+        });
+      })
+    };
+  }
+
+  async searchDBpia(query, limit = 10, output = parseOutputOptions(), signal) {
+    try {
+      const items = await this.loadDocuments(query, limit, 1, { signal });
+      throwIfCancelled(signal);
+      this.prefetchNext(query, limit, 1, items);
+      const merged = (await this.clusterItems(items)).map(cluster => cluster.item);
+      const note = merged.length < items.length ? `, 중복 ${items.length - merged.length}건 병합` : '';
+
+      return {
+        jsonrpc: "2.0",
+        id: null,
+        result: this.metrics.time('format', () => toolResult(output,
+          `DBpia 검색 결과 (키워드: "${query}"${note}):\n\n${formatItems(merged, 0, output)}`,
+          { query, items: merged.map(item => projectItem(item, output)) }))
+      };
     } catch (error) {
       return {
         jsonrpc: "2.0",
@@ -120,7 +449,222 @@ class DBpiaSearchMCP {
     }
   }
 
-  async handleRequest(request) {
+  async searchDBpiaPaged(arguments_, output = parseOutputOptions(), { progressToken, signal } = {}) {
+    const query = arguments_.query;
+    const pageSize = Math.min(Math.max(parseInt(arguments_.page_size, 10) || 10, 1), MAX_PAGE_SIZE);
+    const pages = Math.min(Math.max(parseInt(arguments_.pages, 10) || 1, 1), MAX_PAGES_PER_CALL);
+    const firstPage = parseCursor(arguments_.cursor);
+    const progressive = Boolean(arguments_.progressive) && progressToken !== undefined;
+
+    // 페이지 요청은 동시에 시작하되 결과는 페이지 순서대로 소비
+    const pending = [];
+    for (let page = firstPage; page < firstPage + pages; page++) {
+      const promise = this.loadDocuments(query, pageSize, page, { signal });
+      promise.catch(() => {});
+      pending.push(promise);
+    }
+
+    const sections = [];
+    const records = [];
+    let loaded = 0;
+    let nextCursor = null;
+    let failure = null;
+    for (let i = 0; i < pending.length; i++) {
+      const page = firstPage + i;
+      let items;
+      try {
+        items = await pending[i];
+        throwIfCancelled(signal);
+      } catch (error) {
+        throwIfCancelled(signal);
+        failure = error;
+        nextCursor = String(page);
+        break;
+      }
+
+      const pageRecords = output.format === 'json' ? items.map(item => projectItem(item, output)) : null;
+      const section = pageRecords
+        ? JSON.stringify({ page, items: pageRecords })
+        : `[페이지 ${page}]\n${formatItems(items, (page - 1) * pageSize, output)}`;
+      sections.push(section);
+      records.push(...(pageRecords || []));
+      loaded++;
+      nextCursor = items.length < pageSize ? null : String(page + 1);
+
+      if (progressive) {
+        this.notify({
+          jsonrpc: "2.0",
+          method: "notifications/progress",
+          params: {
+            progressToken,
+            progress: loaded,
+            total: pages,
+            message: section
+          }
+        });
+      }
+      if (nextCursor === null) {
+        break;
+      }
+      if (i === pending.length - 1) {
+        this.prefetchNext(query, pageSize, page, items);
+      }
+    }
+
+    if (failure && loaded === 0) {
+      return {
+        jsonrpc: "2.0",
+        id: null,
+        error: {
+          code: -32603,
+          message: `DBpia 검색 중 오류 발생: ${failure.message}`
+        }
+      };
+    }
+
+    let text = `DBpia 검색 결과 (키워드: "${query}", 페이지 ${firstPage}-${firstPage + loaded - 1}):\n\n${sections.join('\n')}`;
+    if (failure) {
+      text += `\n⚠️ 페이지 ${nextCursor} 로드 실패: ${failure.message}`;
+    }
+    const data = { query, firstPage, pages: loaded, items: records, nextCursor };
+    if (failure) {
+      data.error = failure.message;
+    }
+    return {
+      jsonrpc: "2.0",
+      id: null,
+      result: this.metrics.time('format', () => toolResult(output, text, data, { nextCursor }))
+    };
+  }
+
+  async searchLocal(query, limit = 10, output = parseOutputOptions()) {
+    // 다른 판본이 합쳐져도 limit 건을 채울 수 있도록 넉넉히 찾은 뒤 묶음의 최고 점수 순으로 자름
+    const candidates = await this.localIndex.search(query, limit * 2);
+    const hits = (await this.clusterItems(candidates.map(({ record }) => record)))
+      .slice(0, limit)
+      .map(({ item, members }) => ({ record: item, score: candidates[members[0]].score }));
+    const { documents } = this.localIndex.stats();
+    return {
+      jsonrpc: "2.0",
+      id: null,
+      result: this.metrics.time('format', () => toolResult(output,
+        `로컬 색인 검색 결과 (키워드: "${query}", 색인된 논문 ${documents}편 중 ${hits.length}건):\n\n` +
+          hits.map(({ record, score }, index) =>
+            `${formatItem(record, index + 1, output)}   점수: ${score.toFixed(3)}\n`
+          ).join('\n'),
+        {
+          query,
+          indexed: documents,
+          items: hits.map(({ record, score }) => ({ ...projectItem(record, output), score: Number(score.toFixed(3)) }))
+        }))
+    };
+  }
+
+  async searchDBpiaBatch(queries, limit = 10, output = parseOutputOptions(), signal) {
+    if (!Array.isArray(queries) || queries.length === 0) {
+      throw new InvalidParamsError('queries must be a non-empty array of strings');
+    }
+    // 정규형이 같은 키워드는 처음 나온 표기 하나만 검색
+    const byCanonical = new Map();
+    for (const query of queries.map(q => String(q).trim()).filter(Boolean)) {
+      const canonical = this.canonicalizer.canonicalize(query);
+      if (!byCanonical.has(canonical)) {
+        byCanonical.set(canonical, query);
+      }
+    }
+    const unique = [...byCanonical.values()];
+    if (unique.length > MAX_BATCH_QUERIES) {
+      throw new InvalidParamsError(`Too many queries: ${unique.length} (max ${MAX_BATCH_QUERIES})`);
+    }
+
+    const results = await mapSettled(unique, this.batchConcurrency,
+      query => this.loadDocuments(query, limit, 1, { signal }));
+    throwIfCancelled(signal);
+
+    // tid 와 근사 중복(다른 판본) 기준으로 병합하고 어떤 키워드에서 나왔는지 기록
+    const found = [];
+    const summary = results.map((result, index) => {
+      const query = unique[index];
+      if (result.status === 'rejected') {
+        return `- ${query}: 오류 (${result.reason.message})`;
+      }
+      found.push(...result.value.map(item => ({ item, query })));
+      return `- ${query}: ${result.value.length}건`;
+    });
+
+    if (results.every(result => result.status === 'rejected')) {
+      return {
+        jsonrpc: "2.0",
+        id: null,
+        error: {
+          code: -32603,
+          message: `DBpia 검색 중 오류 발생: ${results[0].reason.message}`
+        }
+      };
+    }
+
+    const entries = (await this.clusterItems(found.map(({ item }) => item))).map(({ item, members }) => ({
+      item,
+      queries: [...new Set(members.map(index => found[index].query))]
+    }));
+    return {
+      jsonrpc: "2.0",
+      id: null,
+      result: this.metrics.time('format', () => toolResult(output,
+        `DBpia 일괄 검색 결과 (키워드 ${unique.length}개, 고유 논문 ${entries.length}편):\n` +
+          `${summary.join('\n')}\n\n` +
+          entries.map(({ item, queries: matched }, index) =>
+            `${formatItem(item, index + 1, output)}   검색어: ${matched.join(', ')}\n`
+          ).join('\n'),
+        {
+          queries: results.map((result, index) => result.status === 'rejected'
+            ? { query: unique[index], error: result.reason.message }
+            : { query: unique[index], count: result.value.length }),
+          items: entries.map(({ item, queries: matched }) => ({ ...projectItem(item, output), queries: matched }))
+        }))
+    };
+  }
+
+  stats() {
+    return {
+      ...this.metrics.snapshot(),
+      dispatcher: this.dispatcher?.stats() ?? null,
+      writer: this.writer?.stats() ?? null,
+      cache: this.cache.stats(),
+      documentCache: this.documentCache.stats(),
+      singleFlight: this.flights.stats(),
+      canonicalizer: this.canonicalizer.stats(),
+      http: this.http.stats(),
+      rateLimit: this.guard.stats(),
+      prefetch: this.prefetcher.stats(),
+      localIndex: this.localIndex.stats(),
+      duplicates: this.duplicates.stats()
+    };
+  }
+
+  async close() {
+    await this.localIndex.flush().catch(() => {});
+    await this.metricsWriter?.close();
+    this.http.destroy();
+  }
+
+  async handleRequest(request, { queuedMs = 0, signal } = {}) {
+    const start = performance.now();
+    this.metrics.observe('queue', queuedMs);
+    if (request === null || typeof request !== 'object' || Array.isArray(request) || typeof request.method !== 'string') {
+      return {
+        jsonrpc: "2.0",
+        id: request?.id ?? null,
+        error: {
+          code: -32600,
+          message: "Invalid Request"
+        }
+      };
+    }
+    // id 가 없는 알림(notifications/initialized 등)에는 응답하지 않음
+    if (request.id === undefined) {
+      return null;
+    }
     try {
       const { method, params, id } = request;
       
@@ -133,20 +677,24 @@ class DBpiaSearchMCP {
           result = await this.listTools();
           break;
         case "tools/call":
-          result = await this.callTool(params.name, params.arguments);
+          result = await this.callTool(params.name, params.arguments, {
+            progressToken: params._meta?.progressToken,
+            signal
+          });
           break;
         default:
           throw new Error(`Unknown method: ${method}`);
       }
       
       result.id = id;
+      this.metrics.observe(method === "tools/call" ? `tool:${params.name}` : method, performance.now() - start);
       return result;
     } catch (error) {
       return {
         jsonrpc: "2.0",
         id: request.id,
         error: {
-          code: -32603,
+          code: error.rpcCode ?? -32603,
           message: error.message
         }
       };
@@ -156,32 +704,72 @@ class DBpiaSearchMCP {
 
 async function main() {
   const server = new DBpiaSearchMCP();
-  
-  const rl = createInterface({
-    input: process.stdin,
-    output: process.stdout,
-    terminal: false
+  // 클라이언트가 느리게 읽으면 출력 대기량이 상한을 넘는 동안 새 요청 실행과 입력 읽기를 멈춤
+  const writer = new ResponseWriter({
+    stream: process.stdout,
+    maxQueuedBytes: envNumber('DBPIA_MAX_OUTPUT_BYTES', 8 * 1024 * 1024),
+    onPressure: (paused) => paused ? dispatcher.pause() : dispatcher.resume()
   });
+  const write = (message) => writer.write(message);
+  server.notify = write;
+  server.writer = writer;
+  const dispatcher = new RequestDispatcher({
+    handle: (request, context) => server.handleRequest(request, context),
+    write,
+    concurrency: envNumber('DBPIA_MAX_CONCURRENCY', 8)
+  });
+  server.dispatcher = dispatcher;
 
-  for await (const line of rl) {
-    if (line.trim()) {
-      try {
-        const request = JSON.parse(line);
-        const response = await server.handleRequest(request);
-        console.log(JSON.stringify(response));
-      } catch (error) {
-        const errorResponse = {
+  // 취소 알림은 대기열을 거치지 않고 바로 처리 (응답 없음)
+  const isCancellation = message => message?.method === "notifications/cancelled" && message.id === undefined;
+  const cancel = message => dispatcher.cancel(message.params?.requestId);
+
+  const framer = new JsonRpcFramer({
+    onMessage: (message) => {
+      if (!Array.isArray(message)) {
+        if (isCancellation(message)) {
+          cancel(message);
+        } else {
+          dispatcher.dispatch(message);
+        }
+      } else if (message.length === 0) {
+        write({
           jsonrpc: "2.0",
           id: null,
           error: {
-            code: -32700,
-            message: "Parse error"
+            code: -32600,
+            message: "Invalid Request"
           }
-        };
-        console.log(JSON.stringify(errorResponse));
+        });
+      } else {
+        const requests = message.filter(item => !isCancellation(item));
+        message.filter(isCancellation).forEach(cancel);
+        if (requests.length > 0) {
+          dispatcher.dispatchBatch(requests);
+        }
       }
+    },
+    onError: () => {
+      write({
+        jsonrpc: "2.0",
+        id: null,
+        error: {
+          code: -32700,
+          message: "Parse error"
+        }
+      });
     }
+  });
+
+  for await (const chunk of process.stdin) {
+    framer.push(chunk);
+    await writer.ready();
   }
+  framer.end();
+
+  await dispatcher.onIdle();
+  await writer.flush();
+  await server.close();
 }
 
 if (import.meta.url === `file://${process.argv[1]}`) {
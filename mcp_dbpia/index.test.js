@@ -0,0 +1,222 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { DBpiaSearchMCP } from './index.js';
+
+function paper(query, n) {
+  return {
+    title: `${query} 연구 ${n}`,
+    authors: `저자${n}`,
+    journal: '전자공학회논문지',
+    tid: `${query}-${n}`,
+    url: `http://www.dbpia.co.kr/Search/JournalDetail?zid=${query}-${n}`,
+    abstract: `${query} 초록 ${n}`,
+    year: '2024',
+    publisher: '대한전자공학회'
+  };
+}
+
+// 원격 호출(fetchDocuments)만 바꿔 끼운 서버. 캐시·로컬 색인은 임시 디렉터리에 둔다
+function createServer(t, fetchDocuments, env = {}) {
+  const dir = mkdtempSync(join(tmpdir(), 'dbpia-index-test-'));
+  Object.assign(process.env, { DBPIA_API_KEY: 'test-key', DBPIA_CACHE_DIR: dir }, env);
+  const server = new DBpiaSearchMCP();
+  Object.keys(env).forEach(name => delete process.env[name]);
+  const fetches = [];
+  server.fetchDocuments = async (query, limit, page) => {
+    fetches.push([query, limit, page]);
+    return fetchDocuments(query, limit, page);
+  };
+  const notifications = [];
+  server.notify = message => notifications.push(message);
+  t.after(async () => {
+    await server.close();
+    rmSync(dir, { recursive: true, force: true });
+  });
+  return { server, fetches, notifications };
+}
+
+let nextId = 1;
+function callTool(server, name, args, meta) {
+  return server.handleRequest({ jsonrpc: "2.0", id: nextId++, method: "tools/call", params: { name, arguments: args, _meta: meta } });
+}
+
+// 검색어별 전체 결과가 total 건인 원격 (page_size 단위로 잘라 돌려줌)
+const pagedUpstream = total => async (query, limit, page) => {
+  const from = (page - 1) * limit;
+  return Array.from({ length: Math.max(0, Math.min(limit, total - from)) }, (_, i) => paper(query, from + i + 1));
+};
+
+test('search_dbpia_paged: 커서는 다음 페이지 번호, 마지막 페이지가 덜 차면 nextCursor 는 null', async t => {
+  const { server } = createServer(t, pagedUpstream(17));
+  const first = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, pages: 2, format: 'json', fields: ['tid'] });
+  assert.equal(first.result.nextCursor, '3');
+  assert.deepEqual(first.result.structuredContent.items.map(item => item.tid), Array.from({ length: 10 }, (_, i) => `전력-${i + 1}`));
+  assert.equal(first.result.structuredContent.pages, 2);
+
+  const rest = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, pages: 10, cursor: first.result.nextCursor, format: 'json', fields: ['tid'] });
+  assert.equal(rest.result.nextCursor, null);
+  assert.equal(rest.result.structuredContent.firstPage, 3);
+  assert.equal(rest.result.structuredContent.pages, 2, '4페이지(2건)에서 멈춤');
+  assert.deepEqual(rest.result.structuredContent.items.map(item => item.tid).slice(-2), ['전력-16', '전력-17']);
+});
+
+test('search_dbpia_paged: 결과 수가 페이지 크기의 배수면 빈 페이지에서 끝남', async t => {
+  const { server } = createServer(t, pagedUpstream(10));
+  const response = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, pages: 2 });
+  assert.equal(response.result.nextCursor, '3');
+  const last = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, cursor: '3' });
+  assert.equal(last.result.nextCursor, null);
+  assert.match(last.result.content[0].text, /\[페이지 3\]/);
+});
+
+test('search_dbpia_paged: 잘못된 커서는 -32602', async t => {
+  const { server, fetches } = createServer(t, pagedUpstream(10));
+  for (const cursor of ['0', '-1', '2.5', 'abc', '02']) {
+    const response = await callTool(server, 'search_dbpia_paged', { query: '전력', cursor });
+    assert.equal(response.error.code, -32602, cursor);
+    assert.match(response.error.message, /Invalid cursor/);
+  }
+  assert.equal(fetches.length, 0);
+});
+
+test('search_dbpia_paged: 중간 페이지가 실패하면 받은 페이지까지 돌려주고 커서는 실패한 페이지', async t => {
+  const upstream = pagedUpstream(100);
+  const { server } = createServer(t, async (query, limit, page) => {
+    if (page === 2) throw new Error('HTTP 503');
+    return upstream(query, limit, page);
+  });
+  const partial = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, pages: 3, format: 'json', fields: ['tid'] });
+  assert.equal(partial.result.nextCursor, '2');
+  assert.equal(partial.result.structuredContent.pages, 1);
+  assert.match(partial.result.structuredContent.error, /HTTP 503/);
+
+  const failed = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, cursor: '2' });
+  assert.equal(failed.error.code, -32603);
+  assert.match(failed.error.message, /HTTP 503/);
+});
+
+test('search_dbpia_paged: progressive 는 페이지마다 진행 알림을 보냄', async t => {
+  const { server, notifications } = createServer(t, pagedUpstream(12));
+  const response = await callTool(server, 'search_dbpia_paged', { query: '전력', page_size: 5, pages: 5, progressive: true }, { progressToken: 'p1' });
+  assert.equal(response.result.nextCursor, null);
+  assert.deepEqual(notifications.map(({ method, params }) => [method, params.progressToken, params.progress, params.total]), [
+    ['notifications/progress', 'p1', 1, 5],
+    ['notifications/progress', 'p1', 2, 5],
+    ['notifications/progress', 'p1', 3, 5]
+  ]);
+  assert.match(notifications[2].params.message, /^\[페이지 3\]/);
+});
+
+test('search_dbpia_batch: 일부 키워드가 실패해도 나머지 결과와 키워드별 오류를 함께 돌려줌', async t => {
+  const { server } = createServer(t, async query => {
+    if (query === '실패') throw new Error('HTTP 500');
+    // 두 키워드에 같은 논문(공통-1)이 나옴
+    return [paper(query, 1), { ...paper('공통', 1) }];
+  });
+  const response = await callTool(server, 'search_dbpia_batch', { queries: ['전력', '실패', '센서'], format: 'json', fields: ['tid'] });
+  const { queries, items } = response.result.structuredContent;
+  assert.deepEqual(queries, [
+    { query: '전력', count: 2 },
+    { query: '실패', error: 'HTTP 500' },
+    { query: '센서', count: 2 }
+  ]);
+  assert.deepEqual(items, [
+    { tid: '전력-1', queries: ['전력'] },
+    { tid: '공통-1', queries: ['전력', '센서'] },
+    { tid: '센서-1', queries: ['센서'] }
+  ]);
+
+  const text = await callTool(server, 'search_dbpia_batch', { queries: ['전력', '실패'] });
+  assert.match(text.result.content[0].text, /- 실패: 오류 \(HTTP 500\)/);
+  assert.match(text.result.content[0].text, /- 전력: 2건/);
+});
+
+test('search_dbpia_batch: 모든 키워드가 실패하면 오류, 표기만 다른 키워드는 한 번만 검색', async t => {
+  const { server, fetches } = createServer(t, async () => {
+    throw new Error('HTTP 500');
+  });
+  const response = await callTool(server, 'search_dbpia_batch', { queries: ['전력 변환', '전력  변환', ' 전력 변환 '] });
+  assert.equal(response.error.code, -32603);
+  assert.match(response.error.message, /HTTP 500/);
+  assert.deepEqual(fetches.map(([query]) => query), ['전력 변환']);
+});
+
+test('search_dbpia_batch: 빈 목록이나 너무 많은 키워드는 -32602', async t => {
+  const { server, fetches } = createServer(t, pagedUpstream(1));
+  assert.equal((await callTool(server, 'search_dbpia_batch', { queries: [] })).error.code, -32602);
+  const many = Array.from({ length: 51 }, (_, i) => `키워드 ${i}`);
+  const response = await callTool(server, 'search_dbpia_batch', { queries: many });
+  assert.equal(response.error.code, -32602);
+  assert.match(response.error.message, /Too many queries: 51/);
+  assert.equal(fetches.length, 0);
+});
+
+test('get_dbpia_document: 문서 캐시 → 로컬 색인 → 원격 순으로 찾고, 찾은 문서는 캐시에 넣음', async t => {
+  const { server, fetches } = createServer(t, async query => {
+    if (query === 'ERR') throw new Error('HTTP 503');
+    // tid 로 검색하면 tid 가 다른 논문도 섞여 나옴
+    const other = { ...paper('원격', 2), tid: `${query}0` };
+    return query === 'UP' ? [other, { ...paper('원격', 1), tid: 'UP' }] : [other];
+  });
+  await server.documentCache.set('CACHED', { ...paper('캐시', 1), tid: 'CACHED' });
+  await server.localIndex.add([{ ...paper('색인', 1), tid: 'INDEXED' }]);
+
+  const response = await callTool(server, 'get_dbpia_document', { tids: ['CACHED', 'INDEXED', 'UP', 'NONE', 'ERR'], format: 'json', fields: ['tid', 'title'] });
+  const { documents, missing } = response.result.structuredContent;
+  assert.deepEqual(documents, [
+    { tid: 'CACHED', title: '캐시 연구 1' },
+    { tid: 'INDEXED', title: '색인 연구 1' },
+    { tid: 'UP', title: '원격 연구 1' }
+  ]);
+  assert.deepEqual(missing, [{ tid: 'NONE', error: '찾을 수 없음' }, { tid: 'ERR', error: 'HTTP 503' }]);
+  assert.deepEqual(fetches.map(([query]) => query).sort(), ['ERR', 'NONE', 'UP']);
+
+  fetches.length = 0;
+  const again = await callTool(server, 'get_dbpia_document', { tids: ['INDEXED', 'UP'], format: 'json', fields: ['tid'] });
+  assert.equal(again.result.structuredContent.documents.length, 2);
+  assert.deepEqual(fetches, [], '두 번째는 문서 캐시에서');
+  assert.equal((await server.localIndex.get('UP')).title, '원격 연구 1', '원격에서 받은 문서는 로컬 색인에도');
+});
+
+test('get_dbpia_document: 기본 출력은 모든 필드와 초록 전체, 모두 실패하면 오류', async t => {
+  const abstract = '가'.repeat(500);
+  const { server } = createServer(t, async query => {
+    if (query === 'ERR') throw new Error('HTTP 503');
+    return [{ ...paper('원격', 1), tid: query, abstract }];
+  });
+  const response = await callTool(server, 'get_dbpia_document', { tid: 'DOC' });
+  const text = response.result.content[0].text;
+  assert.match(text, /^DBpia 논문 상세 \(1\/1건\)/);
+  assert.ok(text.includes(`초록: ${abstract}\n`));
+  assert.match(text, /출판사: 대한전자공학회/);
+
+  const failed = await callTool(server, 'get_dbpia_document', { tids: ['ERR'] });
+  assert.equal(failed.error.code, -32603);
+});
+
+test('get_dbpia_document: tid 가 없거나 너무 많으면 -32602', async t => {
+  const { server, fetches } = createServer(t, pagedUpstream(1));
+  assert.equal((await callTool(server, 'get_dbpia_document', { tids: [' '] })).error.code, -32602);
+  const tids = Array.from({ length: 21 }, (_, i) => `T${i}`);
+  assert.equal((await callTool(server, 'get_dbpia_document', { tids })).error.code, -32602);
+  assert.equal(fetches.length, 0);
+});
+
+test('빈 결과는 DBPIA_EMPTY_CACHE_TTL 동안만 캐시하고, 결과가 있으면 DBPIA_CACHE_TTL 동안 캐시', async t => {
+  let upstream = async () => [];
+  const { server, fetches } = createServer(t, (...args) => upstream(...args), { DBPIA_EMPTY_CACHE_TTL: '0.05' });
+  const search = async () => (await callTool(server, 'search_dbpia', { query: '전력', format: 'json', fields: ['tid'] })).result.structuredContent.items;
+  assert.deepEqual(await search(), []);
+  assert.deepEqual(await search(), [], '짧은 시간 안에는 캐시에서');
+  assert.equal(fetches.length, 1);
+
+  await new Promise(resolve => setTimeout(resolve, 80));
+  upstream = pagedUpstream(2);
+  assert.deepEqual(await search(), [{ tid: '전력-1' }, { tid: '전력-2' }], '만료 뒤 다시 요청');
+  assert.equal(fetches.length, 2);
+  const [entry] = server.cache.memory.values();
+  assert.ok(entry.expiresAt - Date.now() > 23 * 60 * 60 * 1000);
+});
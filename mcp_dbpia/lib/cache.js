@@ -0,0 +1,214 @@
+// 2단계 검색 결과 캐시
+// 1단계: 크기 제한 메모리 LRU, 2단계: 재시작 후에도 유지되는 디스크 저장소
+// 각 항목은 TTL을 가지며 만료된 항목은 조회 시 제거된다.
+// 디스크 계층은 처음 쓸 때 한 번 디렉터리를 훑어 만료된 파일(수정 시각 + TTL 기준)과 남은 임시 파일을 지우고,
+// 이후 전체 크기가 maxBytes 를 넘으면 오래 전에 쓴 파일부터 지운다.
+
+import { mkdir, readdir, readFile, stat, writeFile, rename, unlink } from 'fs/promises';
+import { join } from 'path';
+
+// crypto(와 그에 딸린 stream 모듈)는 디스크 캐시를 처음 쓸 때 불러옴 (기동 시간 단축)
+let crypto = null;
+
+const ENTRY_FILE = /^[0-9a-f]{40}\.json$/;
+const TEMP_FILE = /^[0-9a-f]{40}\.json\..+\.tmp$/;
+const STALE_TEMP_MS = 60 * 1000;
+
+export class ResultCache {
+  constructor({ maxEntries = 500, ttlMs = 24 * 60 * 60 * 1000, dir = null, maxBytes = 64 * 1024 * 1024 } = {}) {
+    this.maxEntries = Math.max(1, maxEntries);
+    this.ttlMs = ttlMs;
+    this.dir = dir;
+    this.maxBytes = maxBytes;
+    this.memory = new Map();
+    this.dirReady = null;
+    this.sweeping = null;
+    // 디스크 파일 경로 → 크기 (오래 쓴 순서). 첫 정리가 끝나기 전에는 이번 실행에서 쓴 파일만 들어 있음
+    this.diskFiles = new Map();
+    this.diskBytes = 0;
+    this.swept = false;
+    this.tempSeq = 0;
+    this.counters = {
+      memoryHits: 0,
+      diskHits: 0,
+      misses: 0,
+      expired: 0,
+      evictions: 0,
+      writes: 0,
+      diskErrors: 0,
+      diskPruned: 0
+    };
+  }
+
+  async get(key) {
+    const now = Date.now();
+    const entry = this.memory.get(key);
+    if (entry) {
+      this.memory.delete(key);
+      if (entry.expiresAt > now) {
+        this.memory.set(key, entry);
+        this.counters.memoryHits++;
+        return entry.value;
+      }
+      this.counters.expired++;
+    }
+
+    if (this.dir) {
+      const stored = await this.readDisk(key);
+      if (stored && stored.key === key) {
+        if (stored.expiresAt > now) {
+          this.remember(key, stored);
+          this.counters.diskHits++;
+          return stored.value;
+        }
+        this.counters.expired++;
+        this.pathFor(key).then(path => this.removeFile(path)).catch(() => {});
+      }
+    }
+
+    this.counters.misses++;
+    return undefined;
+  }
+
+  // 메모리 계층에 유효한 항목이 있는지 (카운터에 영향 없음)
+  has(key) {
+    const entry = this.memory.get(key);
+    return Boolean(entry && entry.expiresAt > Date.now());
+  }
+
+  async set(key, value, ttlMs = this.ttlMs) {
+    const entry = { key, value, expiresAt: Date.now() + ttlMs };
+    this.remember(key, entry);
+    this.counters.writes++;
+    if (this.dir) {
+      await this.writeDisk(key, entry);
+    }
+  }
+
+  remember(key, entry) {
+    this.memory.delete(key);
+    this.memory.set(key, entry);
+    while (this.memory.size > this.maxEntries) {
+      this.memory.delete(this.memory.keys().next().value);
+      this.counters.evictions++;
+    }
+  }
+
+  async pathFor(key) {
+    crypto ??= await import('crypto');
+    const digest = crypto.createHash('sha1').update(key).digest('hex');
+    return join(this.dir, `${digest}.json`);
+  }
+
+  async readDisk(key) {
+    try {
+      return JSON.parse(await readFile(await this.pathFor(key), 'utf8'));
+    } catch (error) {
+      if (error.code !== 'ENOENT') {
+        this.counters.diskErrors++;
+      }
+      return null;
+    }
+  }
+
+  // 임시 파일에 쓴 뒤 rename 하여 동시 실행 중인 다른 프로세스가 반쯤 쓰인 파일을 읽지 않도록 함
+  async writeDisk(key, entry) {
+    try {
+      this.dirReady ||= mkdir(this.dir, { recursive: true });
+      await this.dirReady;
+      this.sweeping ||= this.sweep().catch(() => {
+        this.counters.diskErrors++;
+      });
+      const target = await this.pathFor(key);
+      const temp = `${target}.${process.pid}.${++this.tempSeq}.tmp`;
+      const data = JSON.stringify(entry);
+      await writeFile(temp, data);
+      await rename(temp, target);
+      this.track(target, Buffer.byteLength(data));
+      await this.prune();
+    } catch (error) {
+      this.dirReady = null;
+      this.counters.diskErrors++;
+    }
+  }
+
+  track(path, size) {
+    this.diskBytes -= this.diskFiles.get(path) || 0;
+    this.diskFiles.delete(path);
+    this.diskFiles.set(path, size);
+    this.diskBytes += size;
+  }
+
+  async removeFile(path) {
+    if (this.diskFiles.has(path)) {
+      this.diskBytes -= this.diskFiles.get(path);
+      this.diskFiles.delete(path);
+    }
+    await unlink(path).catch(() => {});
+  }
+
+  // 디렉터리를 훑어 만료된 항목·남은 임시 파일을 지우고 나머지 파일의 크기를 수정 시각 순으로 기록
+  // (이 캐시의 항목 파일만 건드림: 같은 디렉터리의 로컬 색인·하위 디렉터리는 그대로 둠)
+  async sweep() {
+    const now = Date.now();
+    const scanned = [];
+    for (const name of await readdir(this.dir)) {
+      const entry = ENTRY_FILE.test(name);
+      if (!entry && !TEMP_FILE.test(name)) continue;
+      const path = join(this.dir, name);
+      let info;
+      try {
+        info = await stat(path);
+      } catch (error) {
+        continue;
+      }
+      if (entry ? info.mtimeMs + this.ttlMs <= now : info.mtimeMs + STALE_TEMP_MS <= now) {
+        await unlink(path).catch(() => {});
+        this.counters.diskPruned++;
+      } else if (entry) {
+        scanned.push({ path, size: info.size, mtimeMs: info.mtimeMs });
+      }
+    }
+    scanned.sort((a, b) => a.mtimeMs - b.mtimeMs);
+    // 훑는 동안 새로 쓴 파일은 이미 기록되어 있으므로 그 앞에 끼워 넣음
+    const written = this.diskFiles;
+    this.diskFiles = new Map();
+    this.diskBytes = 0;
+    for (const { path, size } of scanned) {
+      if (!written.has(path)) this.track(path, size);
+    }
+    for (const [path, size] of written) {
+      this.track(path, size);
+    }
+    this.swept = true;
+    await this.prune();
+  }
+
+  async prune() {
+    if (!this.swept) return;
+    while (this.diskBytes > this.maxBytes && this.diskFiles.size > 1) {
+      await this.removeFile(this.diskFiles.keys().next().value);
+      this.counters.diskPruned++;
+    }
+  }
+
+  stats() {
+    const { memoryHits, diskHits, misses } = this.counters;
+    const lookups = memoryHits + diskHits + misses;
+    return {
+      ...this.counters,
+      size: this.memory.size,
+      maxEntries: this.maxEntries,
+      diskBytes: this.diskBytes,
+      maxBytes: this.maxBytes,
+      hitRate: lookups ? (memoryHits + diskHits) / lookups : 0
+    };
+  }
+}
+
+// 캐시 키: 공백을 정리하고 소문자화한 검색어 + 결과 수 (+ 2페이지 이후는 페이지 번호)
+export function searchCacheKey(query, limit, page = 1) {
+  const normalized = String(query).trim().replace(/\s+/g, ' ').toLowerCase();
+  const key = `search:${normalized}:${limit}`;
+  return page > 1 ? `${key}:p${page}` : key;
+}
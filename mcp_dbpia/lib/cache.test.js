@@ -0,0 +1,84 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { mkdtemp, readdir, rm, utimes, writeFile } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { ResultCache, searchCacheKey } from './cache.js';
+
+async function tempDir(t) {
+  const dir = await mkdtemp(join(tmpdir(), 'dbpia-cache-'));
+  t.after(() => rm(dir, { recursive: true, force: true }));
+  return dir;
+}
+
+const entryFiles = async dir => (await readdir(dir)).filter(name => /^[0-9a-f]{40}\.json$/.test(name));
+
+test('메모리 LRU: 최근에 읽은 항목은 남기고 가장 오래된 항목을 밀어냄', async () => {
+  const cache = new ResultCache({ maxEntries: 2 });
+  await cache.set('a', 1);
+  await cache.set('b', 2);
+  assert.equal(await cache.get('a'), 1);
+  await cache.set('c', 3);
+  assert.equal(await cache.get('b'), undefined);
+  assert.equal(await cache.get('a'), 1);
+  assert.equal(cache.stats().evictions, 1);
+});
+
+test('TTL 이 지난 항목은 만료', async () => {
+  const cache = new ResultCache();
+  await cache.set('a', 1, -1);
+  assert.equal(cache.has('a'), false);
+  assert.equal(await cache.get('a'), undefined);
+  assert.equal(cache.stats().expired, 1);
+});
+
+test('디스크 계층은 재시작 뒤에도 조회됨', async t => {
+  const dir = await tempDir(t);
+  await new ResultCache({ dir }).set('a', { items: [1, 2] });
+  const cache = new ResultCache({ dir });
+  assert.deepEqual(await cache.get('a'), { items: [1, 2] });
+  assert.equal(cache.stats().diskHits, 1);
+});
+
+test('디스크 크기가 maxBytes 를 넘으면 오래 전에 쓴 파일부터 지움', async t => {
+  const dir = await tempDir(t);
+  const value = 'x'.repeat(1000);
+  const cache = new ResultCache({ dir, maxEntries: 1, maxBytes: 3500 });
+  for (const key of ['a', 'b', 'c', 'd', 'e']) {
+    await cache.set(key, value);
+  }
+  await cache.sweeping;
+  assert.ok(cache.stats().diskBytes <= 3500);
+  assert.equal((await entryFiles(dir)).length, 3);
+  const reopened = new ResultCache({ dir });
+  assert.equal(await reopened.get('a'), undefined);
+  assert.equal(await reopened.get('e'), value);
+});
+
+test('처음 쓸 때 만료된 파일과 남은 임시 파일을 정리하고 다른 파일은 건드리지 않음', async t => {
+  const dir = await tempDir(t);
+  const old = new ResultCache({ dir });
+  await old.set('old', 1);
+  await old.set('fresh', 2);
+  const oldPath = await old.pathFor('old');
+  const hourAgo = new Date(Date.now() - 60 * 60 * 1000);
+  await utimes(oldPath, hourAgo, hourAgo);
+  await writeFile(`${oldPath}.123.1.tmp`, '{');
+  await utimes(`${oldPath}.123.1.tmp`, hourAgo, hourAgo);
+  await writeFile(join(dir, 'local-index.json'), '{}');
+
+  const cache = new ResultCache({ dir, ttlMs: 30 * 60 * 1000 });
+  await cache.set('new', 3);
+  await cache.sweeping;
+  const names = await readdir(dir);
+  assert.ok(!names.some(name => name.endsWith('.tmp')));
+  assert.ok(names.includes('local-index.json'));
+  assert.equal((await entryFiles(dir)).length, 2);
+  assert.equal(cache.stats().diskPruned, 2);
+  assert.equal(await cache.get('fresh'), 2);
+});
+
+test('검색 캐시 키: 공백·대소문자 정리, 2페이지부터 페이지 번호', () => {
+  assert.equal(searchCacheKey('  Deep   Learning ', 10), 'search:deep learning:10');
+  assert.equal(searchCacheKey('a', 10, 2), 'search:a:10:p2');
+});
@@ -0,0 +1,32 @@
+// 요청 취소(notifications/cancelled) 지원 도우미
+
+export function cancelledError() {
+  const error = new Error('요청이 취소되었습니다');
+  error.cancelled = true;
+  return error;
+}
+
+export function throwIfCancelled(signal) {
+  if (signal?.aborted) {
+    throw cancelledError();
+  }
+}
+
+// 취소되면 즉시 reject 되는 setTimeout
+export function sleep(ms, signal) {
+  return new Promise((resolve, reject) => {
+    if (signal?.aborted) {
+      reject(cancelledError());
+      return;
+    }
+    const onAbort = () => {
+      clearTimeout(timer);
+      reject(cancelledError());
+    };
+    const timer = setTimeout(() => {
+      signal?.removeEventListener('abort', onAbort);
+      resolve();
+    }, ms);
+    signal?.addEventListener('abort', onAbort, { once: true });
+  });
+}
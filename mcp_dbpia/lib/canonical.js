@@ -0,0 +1,91 @@
+// 검색어 정규화 (캐시·병합 키 통일)
+// "전력 관리", "전력  관리 ", 대소문자 차이, 다른 유니코드 정규형(NFD 한글 등)을
+// 같은 검색으로 취급하도록 NFC → 소문자화 → 구분용 문장부호 제거 → 공백 정리 →
+// (선택) 동의어 치환과 불용어 제거를 거친 정규형을 만든다.
+// 토큰 안의 - . / + # & _ 는 의미가 있으므로(C++, RISC-V, 802.11) 유지하고 앞뒤에 붙은 것만 떼어 낸다.
+// 구문·연산자로 쓰일 수 있는 문자(따옴표, 괄호, | ! * ~ ^ < > = ? :)는 검색 의미를 바꾸므로 지우지 않는다
+// ("deep learning" 과 deep learning 은 다른 키). 정규형은 키로만 쓰고 원격에는 원래 검색어를 보낸다.
+
+import { readFileSync } from 'fs';
+
+const SEPARATORS = /[,;`\\·・、。…]+/gu;
+const EDGE = /^[-./&_]+|[-./&_]+$/g;
+
+export class QueryCanonicalizer {
+  constructor({ synonyms = {}, stopWords = [] } = {}) {
+    this.synonyms = new Map();
+    this.maxPhrase = 1;
+    for (const [from, to] of Object.entries(synonyms)) {
+      const phrase = this.fold(from);
+      if (phrase.length > 0) {
+        this.synonyms.set(phrase.join(' '), this.fold(to));
+        this.maxPhrase = Math.max(this.maxPhrase, phrase.length);
+      }
+    }
+    this.stopWords = new Set(stopWords.flatMap(word => this.fold(word)));
+    this.counters = {
+      queries: 0,
+      rewritten: 0
+    };
+  }
+
+  // { "synonyms": { "pmic": "전력 관리 ic" }, "stopWords": ["논문", "연구"] } 형식의 JSON 파일
+  static fromFile(path) {
+    if (!path) {
+      return new QueryCanonicalizer();
+    }
+    try {
+      return new QueryCanonicalizer(JSON.parse(readFileSync(path, 'utf8')));
+    } catch (error) {
+      throw new Error(`Invalid query synonym file ${path}: ${error.message}`);
+    }
+  }
+
+  fold(text) {
+    return String(text ?? '')
+      .normalize('NFC')
+      .toLowerCase()
+      .replace(SEPARATORS, ' ')
+      .split(/\s+/)
+      .map(token => token.replace(EDGE, ''))
+      .filter(Boolean);
+  }
+
+  // 가장 긴 구(phrase)부터 동의어 표와 대조하여 치환
+  expand(tokens) {
+    const expanded = [];
+    for (let i = 0; i < tokens.length;) {
+      let length = 1;
+      let replacement = null;
+      for (let n = Math.min(this.maxPhrase, tokens.length - i); n > 0 && !replacement; n--) {
+        replacement = this.synonyms.get(tokens.slice(i, i + n).join(' ')) ?? null;
+        length = n;
+      }
+      expanded.push(...(replacement ?? [tokens[i]]));
+      i += replacement ? length : 1;
+    }
+    return expanded;
+  }
+
+  canonicalize(query) {
+    this.counters.queries++;
+    const tokens = this.fold(query);
+    const expanded = this.synonyms.size > 0 ? this.expand(tokens) : tokens;
+    const kept = expanded.filter(token => !this.stopWords.has(token));
+    // 불용어만으로 된 검색어는 그대로 둠, 문장부호만 있으면 원문(NFC) 유지
+    const canonical = (kept.length > 0 ? kept : expanded).join(' ')
+      || String(query ?? '').normalize('NFC').trim();
+    if (canonical !== String(query ?? '').trim()) {
+      this.counters.rewritten++;
+    }
+    return canonical;
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      synonyms: this.synonyms.size,
+      stopWords: this.stopWords.size
+    };
+  }
+}
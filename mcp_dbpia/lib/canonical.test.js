@@ -0,0 +1,42 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { QueryCanonicalizer } from './canonical.js';
+
+test('공백·대소문자·유니코드 정규형 차이는 같은 키', () => {
+  const canonicalizer = new QueryCanonicalizer();
+  const forms = ['전력 관리', '  전력   관리 ', '전력 관리'.normalize('NFD'), '전력, 관리'];
+  assert.deepEqual(new Set(forms.map(form => canonicalizer.canonicalize(form))), new Set(['전력 관리']));
+  assert.equal(canonicalizer.canonicalize('Deep Learning'), 'deep learning');
+});
+
+test('토큰 안의 기호는 유지하고 앞뒤에 붙은 것만 제거', () => {
+  const canonicalizer = new QueryCanonicalizer();
+  assert.equal(canonicalizer.canonicalize('C++ RISC-V 802.11'), 'c++ risc-v 802.11');
+  assert.equal(canonicalizer.canonicalize('-센서. _모듈_'), '센서 모듈');
+});
+
+test('구문·연산자 문자는 의미가 바뀌지 않도록 유지', () => {
+  const canonicalizer = new QueryCanonicalizer();
+  assert.equal(canonicalizer.canonicalize('"Deep Learning"'), '"deep learning"');
+  assert.notEqual(canonicalizer.canonicalize('"deep learning"'), canonicalizer.canonicalize('deep learning'));
+  assert.equal(canonicalizer.canonicalize('a|b'), 'a|b');
+  assert.equal(canonicalizer.canonicalize('!x'), '!x');
+  assert.equal(canonicalizer.canonicalize('(센서 | 모듈) 전력*'), '(센서 | 모듈) 전력*');
+});
+
+test('동의어는 가장 긴 구부터 치환하고 불용어는 제거', () => {
+  const canonicalizer = new QueryCanonicalizer({
+    synonyms: { 'power management': '전력 관리', 'power': '전원', 'PMIC': '전력 관리 ic' },
+    stopWords: ['논문']
+  });
+  assert.equal(canonicalizer.canonicalize('Power Management 논문'), '전력 관리');
+  assert.equal(canonicalizer.canonicalize('power supply'), '전원 supply');
+  assert.equal(canonicalizer.canonicalize('pmic'), '전력 관리 ic');
+  assert.equal(canonicalizer.canonicalize('논문'), '논문', '불용어만 있으면 그대로');
+  assert.equal(canonicalizer.stats().synonyms, 3);
+});
+
+test('문장부호만 있는 검색어는 원문 유지', () => {
+  const canonicalizer = new QueryCanonicalizer();
+  assert.equal(canonicalizer.canonicalize(' ,;… '), ',;…');
+});
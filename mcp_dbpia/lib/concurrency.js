@@ -0,0 +1,25 @@
+// 동시 실행 수를 제한하는 병렬 map
+// 결과는 입력 순서대로 { status, value | reason } 형태로 반환 (Promise.allSettled와 동일)
+
+export async function mapSettled(values, limit, fn) {
+  const results = new Array(values.length);
+  let next = 0;
+
+  const worker = async () => {
+    while (next < values.length) {
+      const index = next++;
+      try {
+        results[index] = { status: 'fulfilled', value: await fn(values[index], index) };
+      } catch (reason) {
+        results[index] = { status: 'rejected', reason };
+      }
+    }
+  };
+
+  const workers = [];
+  for (let i = 0; i < Math.min(Math.max(1, limit), values.length); i++) {
+    workers.push(worker());
+  }
+  await Promise.all(workers);
+  return results;
+}
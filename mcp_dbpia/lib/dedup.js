@@ -0,0 +1,211 @@
+// 근사 중복 논문 묶기 (MinHash + LSH)
+// tid 가 같거나, 정규화한 제목의 문자 shingle 과 저자 집합의 MinHash 유사도가 threshold 이상인
+// 레코드(학술대회판과 학술지판 등)를 하나의 묶음으로 합친다.
+// 지금까지 본 모든 논문의 서명을 LSH 버킷에 보관하므로, 다른 검색·다른 세션(로컬 색인)에서
+// 받은 판본도 같은 대표 tid(가장 먼저 본 판본)로 묶인다.
+// 버킷은 최근에 넣은 MAX_BUCKET 개만 유지한다. 제목 틀과 저자가 같은 논문이 많으면 같은 버킷이 끝없이 커져
+// 새 논문마다 그 전부와 비교하게 되므로, 비교 횟수를 논문 하나당 BANDS × MAX_BUCKET 이하로 제한한다.
+
+const NUM_HASHES = 64;
+const BANDS = 16;
+const ROWS = NUM_HASHES / BANDS;
+const SHINGLE = 3;
+const MAX_BUCKET = 32;
+
+// 해시 함수마다 다른 시드 (고정값이라 프로세스가 달라도 서명이 같음)
+const SEEDS = Uint32Array.from({ length: NUM_HASHES }, (_, i) => fmix32((i + 1) * 0x9e3779b9));
+
+function fmix32(h) {
+  h ^= h >>> 16;
+  h = Math.imul(h, 0x85ebca6b);
+  h ^= h >>> 13;
+  h = Math.imul(h, 0xc2b2ae35);
+  h ^= h >>> 16;
+  return h >>> 0;
+}
+
+function fnv1a(text) {
+  let h = 0x811c9dc5;
+  for (let i = 0; i < text.length; i++) {
+    h ^= text.charCodeAt(i);
+    h = Math.imul(h, 0x01000193);
+  }
+  return h >>> 0;
+}
+
+export function normalizeText(text) {
+  return String(text ?? '').normalize('NFC').toLowerCase().replace(/[^\p{L}\p{N}]+/gu, ' ').trim();
+}
+
+// 제목은 띄어쓰기 차이를 무시한 문자 3-gram, 저자는 이름 단위
+export function features(record) {
+  const set = new Set();
+  const title = [...normalizeText(record.title).replace(/ /g, '')];
+  if (title.length > 0 && title.length <= SHINGLE) {
+    set.add(`t:${title.join('')}`);
+  }
+  for (let i = 0; i + SHINGLE <= title.length; i++) {
+    set.add(`t:${title.slice(i, i + SHINGLE).join('')}`);
+  }
+  for (const author of String(record.authors ?? '').split(/[;,]/)) {
+    const name = normalizeText(author).replace(/ /g, '');
+    if (name) {
+      set.add(`a:${name}`);
+    }
+  }
+  return set;
+}
+
+// 제목 속 숫자("1부"/"2부", "5G"/"6G")가 다르면 제목이 거의 같아도 다른 논문으로 봄
+function titleNumbers(record) {
+  return (normalizeText(record.title).match(/\p{N}+/gu) || []).join(',');
+}
+
+// 제목·저자가 모두 비어 있으면 null (유사도 비교 대상에서 제외)
+export function signature(record) {
+  const set = features(record);
+  if (set.size === 0) return null;
+  const minimums = new Uint32Array(NUM_HASHES).fill(0xffffffff);
+  for (const feature of set) {
+    const base = fnv1a(feature);
+    for (let i = 0; i < NUM_HASHES; i++) {
+      const h = fmix32(base ^ SEEDS[i]);
+      if (h < minimums[i]) {
+        minimums[i] = h;
+      }
+    }
+  }
+  return minimums;
+}
+
+// 일치하는 최솟값 비율 = Jaccard 유사도 추정치
+export function similarity(a, b) {
+  let same = 0;
+  for (let i = 0; i < NUM_HASHES; i++) {
+    if (a[i] === b[i]) same++;
+  }
+  return same / NUM_HASHES;
+}
+
+export class DuplicateIndex {
+  constructor({ threshold = 0.7 } = {}) {
+    this.threshold = threshold;
+    this.signatures = new Map();
+    this.buckets = new Map();
+    this.parent = new Map();
+    this.order = new Map();
+    this.numbers = new Map();
+    this.clusters = new Map();
+    this.counters = {
+      merges: 0,
+      comparisons: 0,
+      bucketEvictions: 0
+    };
+  }
+
+  find(tid) {
+    let root = tid;
+    while (this.parent.get(root) !== root) {
+      root = this.parent.get(root);
+    }
+    // 경로 압축
+    while (tid !== root) {
+      const next = this.parent.get(tid);
+      this.parent.set(tid, root);
+      tid = next;
+    }
+    return root;
+  }
+
+  // 먼저 본 판본이 대표가 되도록 합침
+  union(a, b) {
+    const rootA = this.find(a);
+    const rootB = this.find(b);
+    if (rootA === rootB) return;
+    const [older, newer] = this.order.get(rootA) < this.order.get(rootB) ? [rootA, rootB] : [rootB, rootA];
+    this.parent.set(newer, older);
+    this.clusters.get(older).push(...this.clusters.get(newer));
+    this.clusters.delete(newer);
+    this.counters.merges++;
+  }
+
+  add(record) {
+    const tid = record?.tid;
+    if (!tid || this.signatures.has(tid)) return;
+    const minimums = signature(record);
+    this.signatures.set(tid, minimums);
+    this.parent.set(tid, tid);
+    this.order.set(tid, this.order.size);
+    this.clusters.set(tid, [tid]);
+    if (!minimums || this.threshold > 1) return;
+    const numbers = titleNumbers(record);
+    this.numbers.set(tid, numbers);
+
+    const checked = new Set();
+    for (let band = 0; band < BANDS; band++) {
+      const key = `${band}:${minimums.subarray(band * ROWS, (band + 1) * ROWS).join(',')}`;
+      let bucket = this.buckets.get(key);
+      if (!bucket) {
+        bucket = [];
+        this.buckets.set(key, bucket);
+      }
+      for (const other of bucket) {
+        if (checked.has(other)) continue;
+        checked.add(other);
+        this.counters.comparisons++;
+        if (this.numbers.get(other) === numbers &&
+            similarity(minimums, this.signatures.get(other)) >= this.threshold) {
+          this.union(tid, other);
+        }
+      }
+      bucket.push(tid);
+      if (bucket.length > MAX_BUCKET) {
+        bucket.shift();
+        this.counters.bucketEvictions++;
+      }
+    }
+  }
+
+  // items 를 묶음 단위로 나눔: [{ item, members }] (members 는 items 의 인덱스, 입력 순서 유지)
+  // item 은 묶음의 첫 레코드에 비어 있는 필드를 다른 판본으로 채우고, 다른 판본이 있으면
+  // duplicates(tid 목록: 이번 결과에 있는 것 먼저, 이전에 본 것 나중)를 붙인 것
+  group(items) {
+    items.forEach(item => this.add(item));
+    const clusters = new Map();
+    items.forEach((item, index) => {
+      const key = item.tid ? this.find(item.tid) : `#${index}`;
+      const cluster = clusters.get(key);
+      if (cluster) {
+        cluster.members.push(index);
+      } else {
+        clusters.set(key, { key, members: [index] });
+      }
+    });
+
+    return [...clusters.values()].map(({ key, members }) => {
+      const records = members.map(index => items[index]);
+      const item = { ...records[0] };
+      for (const other of records.slice(1)) {
+        for (const [field, value] of Object.entries(other)) {
+          if (!item[field] && value) {
+            item[field] = value;
+          }
+        }
+      }
+      const known = this.clusters.get(key) ?? [];
+      const duplicates = [...new Set([...records.map(record => record.tid), ...known])].filter(tid => tid && tid !== item.tid);
+      if (duplicates.length > 0) {
+        item.duplicates = duplicates;
+      }
+      return { item, members };
+    });
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      documents: this.signatures.size,
+      threshold: this.threshold
+    };
+  }
+}
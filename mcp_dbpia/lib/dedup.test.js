@@ -0,0 +1,70 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { DuplicateIndex, features, signature, similarity } from './dedup.js';
+
+test('서명은 프로세스와 무관하게 결정적이고, 같은 특징 집합이면 유사도 1', () => {
+  const record = { title: '딥러닝 기반 전력 관리', authors: '홍길동; 김철수' };
+  assert.deepEqual(signature(record), signature({ ...record }));
+  assert.equal(similarity(signature(record), signature({ title: '딥러닝기반 전력관리!', authors: '김철수, 홍길동' })), 1);
+  assert.equal(signature({ title: '', authors: '' }), null);
+  assert.ok(features(record).has('a:홍길동'));
+});
+
+test('제목 띄어쓰기·문장부호만 다른 판본은 먼저 본 tid 를 대표로 묶고 빈 필드를 채움', () => {
+  const index = new DuplicateIndex();
+  const groups = index.group([
+    { tid: 'CONF1', title: '저전력 IoT 센서 네트워크를 위한 적응형 라우팅 기법', authors: '홍길동;김철수', journal: '' },
+    { tid: 'OTHER', title: '영상 처리 가속기 설계', authors: '이영희' },
+    { tid: 'JOUR1', title: '저전력 IoT 센서네트워크를 위한 적응형 라우팅 기법.', authors: '홍길동;김철수', journal: '정보과학회논문지' }
+  ]);
+  assert.equal(groups.length, 2);
+  assert.deepEqual(groups[0].members, [0, 2]);
+  assert.equal(groups[0].item.tid, 'CONF1');
+  assert.equal(groups[0].item.journal, '정보과학회논문지');
+  assert.deepEqual(groups[0].item.duplicates, ['JOUR1']);
+  assert.equal(groups[1].item.duplicates, undefined);
+});
+
+test('제목 속 숫자가 다르면 묶지 않음', () => {
+  const index = new DuplicateIndex();
+  const groups = index.group([
+    { tid: 'A', title: '5G 이동통신 시스템의 자원 할당 최적화 연구', authors: '홍길동' },
+    { tid: 'B', title: '6G 이동통신 시스템의 자원 할당 최적화 연구', authors: '홍길동' }
+  ]);
+  assert.equal(groups.length, 2);
+});
+
+test('이전 검색에서 본 판본도 묶음의 duplicates 로 알려 줌', () => {
+  const index = new DuplicateIndex();
+  index.group([{ tid: 'OLD', title: '한국어 형태소 분석기의 성능 비교 연구', authors: '김철수' }]);
+  const [group] = index.group([{ tid: 'NEW', title: '한국어 형태소 분석기의 성능 비교연구', authors: '김철수' }]);
+  assert.equal(group.item.tid, 'NEW');
+  assert.deepEqual(group.item.duplicates, ['OLD']);
+  assert.equal(index.find('NEW'), 'OLD', '대표는 먼저 본 판본');
+});
+
+test('threshold 가 1 보다 크면 tid 가 같은 것만 묶음', () => {
+  const index = new DuplicateIndex({ threshold: 1.1 });
+  const groups = index.group([
+    { tid: 'A', title: '같은 제목', authors: '홍길동' },
+    { tid: 'B', title: '같은 제목', authors: '홍길동' },
+    { tid: 'A', title: '같은 제목', authors: '홍길동' }
+  ]);
+  assert.deepEqual(groups.map(group => group.members), [[0, 2], [1]]);
+  assert.equal(index.stats().comparisons, 0);
+});
+
+test('제목 틀이 같은 논문이 많아도 버킷 크기를 제한해 논문당 비교 횟수가 늘지 않고, 최근 판본은 묶음', () => {
+  const index = new DuplicateIndex();
+  const record = n => ({ tid: `T${n}`, title: `전력 변환기 설계 연구 ${n}차 보고서`, authors: '홍길동; 김철수' });
+  for (let n = 0; n < 2000; n++) index.add(record(n));
+  const { comparisons, bucketEvictions } = index.stats();
+  assert.ok(comparisons <= 2000 * 16 * 32, `${comparisons} 회 비교`);
+  assert.ok(bucketEvictions > 0);
+  assert.equal(index.stats().merges, 0, '숫자가 다르면 묶지 않음');
+
+  const before = index.stats().comparisons;
+  const [group] = index.group([{ ...record(1999), tid: 'COPY' }]);
+  assert.ok(index.stats().comparisons - before <= 16 * 32);
+  assert.deepEqual(group.item.duplicates, ['T1999']);
+});
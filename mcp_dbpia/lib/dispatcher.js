@@ -0,0 +1,142 @@
+// JSON-RPC 요청 디스패처
+// 요청을 동시 실행 한도(concurrency) 안에서 병렬로 처리하고,
+// 응답은 완료되는 순서대로 즉시 기록한다 (클라이언트는 id로 매칭).
+// 배치(배열) 요청은 각 요소를 같은 한도 안에서 병렬 처리한 뒤 응답 배열 하나로 기록한다.
+// handle 에는 대기열에서 기다린 시간(queuedMs)과 취소 신호(signal)가 함께 전달된다.
+// cancel(id)는 notifications/cancelled 처리용: 대기 중이면 대기열에서 빼고,
+// 실행 중이면 signal을 abort 한다. 취소된 요청의 응답은 기록하지 않는다.
+// pause()/resume(): 출력이 밀리는 동안 새 요청 실행을 멈춤 (실행 중인 요청은 계속).
+
+export class RequestDispatcher {
+  constructor({ handle, write, concurrency = 8 }) {
+    this.handle = handle;
+    this.write = write;
+    this.concurrency = Math.max(1, concurrency);
+    this.active = 0;
+    this.paused = false;
+    this.pendingBatches = 0;
+    this.queue = [];
+    this.idleWaiters = [];
+    this.entries = new Map();
+    this.cancelled = 0;
+  }
+
+  dispatch(request) {
+    this.submit(request).then(response => {
+      if (response) {
+        this.write(response);
+      }
+    });
+  }
+
+  dispatchBatch(requests) {
+    this.pendingBatches++;
+    Promise.all(requests.map(request => this.submit(request))).then(responses => {
+      const written = responses.filter(Boolean);
+      if (written.length > 0) {
+        this.write(written);
+      }
+    }).finally(() => {
+      this.pendingBatches--;
+      this.checkIdle();
+    });
+  }
+
+  // 응답(알림이면 null)으로 resolve 되는 Promise 반환
+  submit(request) {
+    return new Promise(resolve => {
+      const entry = { request, queuedAt: performance.now(), resolve, controller: new AbortController() };
+      const id = request?.id;
+      if (id !== undefined && id !== null && !this.entries.has(id)) {
+        entry.id = id;
+        this.entries.set(id, entry);
+      }
+      if (!this.paused && this.active < this.concurrency) {
+        this.run(entry);
+      } else {
+        this.queue.push(entry);
+      }
+    });
+  }
+
+  async run(entry) {
+    const { request, queuedAt, resolve, controller } = entry;
+    this.active++;
+    try {
+      const response = await this.handle(request, {
+        queuedMs: performance.now() - queuedAt,
+        signal: controller.signal
+      });
+      resolve(controller.signal.aborted ? null : response);
+    } finally {
+      this.forget(entry);
+      this.active--;
+      if (!this.paused && this.queue.length > 0) {
+        this.run(this.queue.shift());
+      } else {
+        // 응답 기록(then 콜백)이 끝난 뒤 유휴 여부를 판단
+        setImmediate(() => this.checkIdle());
+      }
+    }
+  }
+
+  pause() {
+    this.paused = true;
+  }
+
+  resume() {
+    this.paused = false;
+    while (this.active < this.concurrency && this.queue.length > 0) {
+      this.run(this.queue.shift());
+    }
+  }
+
+  forget(entry) {
+    if (entry.id !== undefined && this.entries.get(entry.id) === entry) {
+      this.entries.delete(entry.id);
+    }
+  }
+
+  // 취소할 요청이 없으면(이미 끝났거나 모르는 id) false
+  cancel(id) {
+    const entry = this.entries.get(id);
+    if (!entry) {
+      return false;
+    }
+    this.forget(entry);
+    this.cancelled++;
+    const index = this.queue.indexOf(entry);
+    if (index !== -1) {
+      this.queue.splice(index, 1);
+      entry.resolve(null);
+      setImmediate(() => this.checkIdle());
+    } else {
+      entry.controller.abort();
+    }
+    return true;
+  }
+
+  checkIdle() {
+    if (this.active === 0 && this.queue.length === 0 && this.pendingBatches === 0) {
+      this.idleWaiters.splice(0).forEach(resolve => resolve());
+    }
+  }
+
+  stats() {
+    return {
+      active: this.active,
+      queued: this.queue.length,
+      cancelled: this.cancelled,
+      paused: this.paused,
+      concurrency: this.concurrency
+    };
+  }
+
+  // 대기열과 실행 중인 요청이 모두 끝날 때까지 기다림
+  onIdle() {
+    return new Promise(resolve => {
+      this.idleWaiters.push(resolve);
+      this.checkIdle();
+    });
+  }
+}
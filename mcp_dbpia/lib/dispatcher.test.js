@@ -0,0 +1,112 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { RequestDispatcher } from './dispatcher.js';
+import { sleep } from './cancel.js';
+
+const wait = ms => new Promise(resolve => setTimeout(resolve, ms));
+
+// params.ms 만큼 걸리는 요청, 알림(id 없음)은 응답 없음
+function setup(options = {}) {
+  const written = [];
+  let running = 0;
+  let peak = 0;
+  const dispatcher = new RequestDispatcher({
+    concurrency: 2,
+    write: message => written.push(message),
+    handle: async (request, context) => {
+      running++;
+      peak = Math.max(peak, running);
+      try {
+        await wait(request.params?.ms ?? 0);
+        return request.id === undefined ? null : { jsonrpc: "2.0", id: request.id, result: context.queuedMs };
+      } finally {
+        running--;
+      }
+    },
+    ...options
+  });
+  return { dispatcher, written, peak: () => peak };
+}
+
+test('동시 실행 한도를 지키고 응답은 끝나는 순서대로 기록', async () => {
+  const { dispatcher, written, peak } = setup();
+  dispatcher.dispatch({ id: 1, params: { ms: 60 } });
+  dispatcher.dispatch({ id: 2, params: { ms: 10 } });
+  dispatcher.dispatch({ id: 3, params: { ms: 10 } });
+  await dispatcher.onIdle();
+  assert.equal(peak(), 2);
+  assert.deepEqual(written.map(response => response.id), [2, 3, 1]);
+  assert.ok(written[1].result >= 5, '세 번째 요청은 대기열에서 기다린 시간이 전달됨');
+});
+
+test('알림은 응답을 기록하지 않음', async () => {
+  const { dispatcher, written } = setup();
+  dispatcher.dispatch({ method: 'notifications/initialized' });
+  dispatcher.dispatch({ id: 1 });
+  await dispatcher.onIdle();
+  assert.deepEqual(written.map(response => response.id), [1]);
+});
+
+test('배치는 같은 한도 안에서 병렬 처리한 뒤 응답 배열 하나로 기록', async () => {
+  const { dispatcher, written, peak } = setup();
+  dispatcher.dispatchBatch([
+    { id: 1, params: { ms: 30 } },
+    { method: 'notifications/initialized' },
+    { id: 2, params: { ms: 10 } },
+    { id: 3, params: { ms: 10 } }
+  ]);
+  await dispatcher.onIdle();
+  assert.equal(peak(), 2);
+  assert.equal(written.length, 1);
+  assert.deepEqual(written[0].map(response => response.id), [1, 2, 3], '배치 응답은 요청 순서');
+});
+
+test('알림만 있는 배치는 아무것도 기록하지 않음', async () => {
+  const { dispatcher, written } = setup();
+  dispatcher.dispatchBatch([{ method: 'a' }, { method: 'b' }]);
+  await dispatcher.onIdle();
+  assert.deepEqual(written, []);
+});
+
+test('취소: 대기 중인 요청은 실행하지 않고, 실행 중인 요청은 signal 을 abort 하고 응답을 버림', async () => {
+  const started = [];
+  let aborted = null;
+  const written = [];
+  const dispatcher = new RequestDispatcher({
+    concurrency: 1,
+    write: message => written.push(message),
+    handle: async (request, { signal }) => {
+      started.push(request.id);
+      try {
+        await sleep(request.params.ms, signal);
+      } catch (error) {
+        aborted = error;
+      }
+      return { jsonrpc: "2.0", id: request.id, result: 'done' };
+    }
+  });
+  dispatcher.dispatch({ id: 1, params: { ms: 1000 } });
+  dispatcher.dispatch({ id: 2, params: { ms: 0 } });
+  dispatcher.dispatch({ id: 3, params: { ms: 0 } });
+  assert.equal(dispatcher.cancel(2), true);
+  assert.equal(dispatcher.cancel(1), true);
+  assert.equal(dispatcher.cancel(99), false, '모르는 id');
+  await dispatcher.onIdle();
+  assert.equal(aborted?.cancelled, true);
+  assert.deepEqual(started, [1, 3]);
+  assert.deepEqual(written.map(response => response.id), [3]);
+  assert.equal(dispatcher.stats().cancelled, 2);
+  assert.equal(dispatcher.cancel(3), false, '이미 끝난 요청');
+});
+
+test('pause 중에는 새 요청을 시작하지 않고 resume 하면 이어서 실행', async () => {
+  const { dispatcher, written } = setup();
+  dispatcher.pause();
+  dispatcher.dispatch({ id: 1 });
+  await wait(10);
+  assert.equal(dispatcher.stats().queued, 1);
+  assert.deepEqual(written, []);
+  dispatcher.resume();
+  await dispatcher.onIdle();
+  assert.deepEqual(written.map(response => response.id), [1]);
+});
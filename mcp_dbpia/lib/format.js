@@ -0,0 +1,123 @@
+// 검색 결과 출력 형식
+// text: 기존 마크다운 목록, json: 요청한 필드만 담은 구조화 레코드 (토큰 절약용)
+
+export const FIELDS = ['title', 'authors', 'journal', 'year', 'publisher', 'tid', 'url', 'abstract'];
+// 검색 결과는 요약 필드만 기본으로 담고, 초록 등 전체 내용은 get_dbpia_document 로 조회
+export const SUMMARY_FIELDS = ['title', 'authors', 'journal', 'year', 'tid'];
+const DEFAULT_ABSTRACT_CHARS = 200;
+
+// get_dbpia_document 기본값: 모든 필드, 초록 전체
+export const DETAIL_OUTPUT = { fields: FIELDS, abstractChars: 0 };
+
+const LABELS = {
+  authors: '저자',
+  journal: '학술지',
+  year: '출판년도',
+  publisher: '출판사',
+  tid: 'TID',
+  url: 'URL',
+  abstract: '초록'
+};
+
+// 모든 검색 도구의 inputSchema 에 공통으로 들어가는 출력 옵션
+export const OUTPUT_PROPERTIES = {
+  format: {
+    type: "string",
+    enum: ["text", "json"],
+    description: "출력 형식: text(마크다운, 기본값) 또는 json(구조화 레코드)",
+    default: "text"
+  },
+  fields: {
+    type: "array",
+    items: { type: "string", enum: FIELDS },
+    description: `결과에 포함할 필드 (기본값: ${JSON.stringify(SUMMARY_FIELDS)}, 예: [\"title\", \"tid\", \"abstract\"])`
+  },
+  abstract_chars: {
+    type: "number",
+    description: `abstract 필드의 최대 글자 수 (기본값: ${DEFAULT_ABSTRACT_CHARS}, 0이면 자르지 않음)`,
+    default: DEFAULT_ABSTRACT_CHARS
+  }
+};
+
+// 도구 인자가 잘못됨 (JSON-RPC Invalid params 로 응답)
+export class InvalidParamsError extends Error {
+  constructor(message) {
+    super(message);
+    this.rpcCode = -32602;
+  }
+}
+
+export function parseOutputOptions(arguments_ = {}, defaults = {}) {
+  const format = arguments_.format === 'json' ? 'json' : 'text';
+  let fields = defaults.fields ?? SUMMARY_FIELDS;
+  if (Array.isArray(arguments_.fields) && arguments_.fields.length > 0) {
+    const unknown = arguments_.fields.filter(field => !FIELDS.includes(field));
+    if (unknown.length > 0) {
+      throw new InvalidParamsError(`Unknown field: ${unknown.join(', ')} (available: ${FIELDS.join(', ')})`);
+    }
+    fields = FIELDS.filter(field => arguments_.fields.includes(field));
+  }
+  const abstractChars = Number.isInteger(arguments_.abstract_chars) && arguments_.abstract_chars >= 0
+    ? arguments_.abstract_chars
+    : defaults.abstractChars ?? DEFAULT_ABSTRACT_CHARS;
+  return { format, fields, abstractChars };
+}
+
+function truncate(text, limit) {
+  if (!limit || text.length <= limit) return text;
+  return `${text.substring(0, limit)}...`;
+}
+
+// 근사 중복으로 합쳐진 다른 판본의 tid(duplicates)는 필드 선택과 무관하게 함께 보냄
+export function projectItem(item, { fields, abstractChars }) {
+  const record = {};
+  for (const field of fields) {
+    const value = item[field] ?? '';
+    if (field === 'year') {
+      const year = parseInt(value, 10);
+      record.year = Number.isNaN(year) ? null : year;
+    } else if (field === 'authors') {
+      record.authors = String(value).split(';').map(name => name.trim()).filter(Boolean);
+    } else if (field === 'abstract') {
+      record.abstract = truncate(value, abstractChars);
+    } else {
+      record[field] = value;
+    }
+  }
+  if (item.duplicates) {
+    record.duplicates = item.duplicates;
+  }
+  return record;
+}
+
+export function formatItem(item, number, { fields, abstractChars } = parseOutputOptions()) {
+  let text = fields.includes('title') ? `${number}. **${item.title}**\n` : `${number}.\n`;
+  for (const field of fields) {
+    if (field === 'title') continue;
+    const value = field === 'abstract' ? truncate(item.abstract ?? '', abstractChars) : item[field] ?? '';
+    text += `   ${LABELS[field]}: ${value}\n`;
+  }
+  if (item.duplicates) {
+    text += `   다른 판본: ${item.duplicates.join(', ')}\n`;
+  }
+  return text;
+}
+
+export function formatItems(items, offset = 0, options) {
+  return items.map((item, index) => formatItem(item, offset + index + 1, options)).join('\n');
+}
+
+// json 형식은 공백 없는 JSON 텍스트와 structuredContent 를 함께 돌려준다
+export function toolResult(options, text, data, extra = {}) {
+  if (options.format === 'json') {
+    return {
+      content: [{ type: "text", text: JSON.stringify(data) }],
+      structuredContent: data,
+      ...extra
+    };
+  }
+  return {
+    content: [{ type: "text", text }],
+    ...extra
+  };
+}
@@ -0,0 +1,74 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { DETAIL_OUTPUT, InvalidParamsError, formatItem, formatItems, parseOutputOptions, projectItem, toolResult } from './format.js';
+
+const item = {
+  title: '전력 변환기 설계',
+  authors: '홍길동; 김철수 ;',
+  journal: '전자공학회논문지',
+  year: '2021',
+  publisher: '대한전자공학회',
+  tid: 'NODE1',
+  url: 'http://www.dbpia.co.kr/Search/JournalDetail?zid=NODE1',
+  abstract: '가'.repeat(250)
+};
+
+// 필드 선택 이전의 출력 (모든 필드, 초록 200자)
+function legacyFormatItem(item, number) {
+  return `${number}. **${item.title}**\n` +
+    `   저자: ${item.authors}\n` +
+    `   학술지: ${item.journal}\n` +
+    `   출판년도: ${item.year}\n` +
+    `   출판사: ${item.publisher}\n` +
+    `   URL: ${item.url}\n` +
+    `   초록: ${item.abstract.substring(0, 200)}${item.abstract.length > 200 ? '...' : ''}\n`;
+}
+
+test('모르는 필드는 -32602 (Invalid params) 오류', () => {
+  assert.throws(() => parseOutputOptions({ fields: ['title', 'doi'] }), error => {
+    assert.ok(error instanceof InvalidParamsError);
+    assert.equal(error.rpcCode, -32602);
+    assert.match(error.message, /Unknown field: doi/);
+    return true;
+  });
+});
+
+test('옵션 기본값과 필드 순서', () => {
+  assert.deepEqual(parseOutputOptions(), { format: 'text', fields: ['title', 'authors', 'journal', 'year', 'tid'], abstractChars: 200 });
+  assert.deepEqual(parseOutputOptions({ format: 'json', fields: ['tid', 'title'], abstract_chars: 0 }),
+    { format: 'json', fields: ['title', 'tid'], abstractChars: 0 });
+  assert.equal(parseOutputOptions({ abstract_chars: -1 }).abstractChars, 200, '음수는 기본값');
+  assert.equal(parseOutputOptions({}, DETAIL_OUTPUT).abstractChars, 0);
+});
+
+test('json 레코드: year 는 숫자, authors 는 배열, 초록은 abstract_chars 로 자름', () => {
+  const output = parseOutputOptions({ format: 'json', fields: ['year', 'authors', 'abstract'], abstract_chars: 10 });
+  assert.deepEqual(projectItem(item, output), { authors: ['홍길동', '김철수'], year: 2021, abstract: `${'가'.repeat(10)}...` });
+  assert.deepEqual(projectItem({ year: '미상', authors: '' }, output), { authors: [], year: null, abstract: '' });
+  assert.equal(projectItem({ abstract: '짧음' }, output).abstract, '짧음');
+  assert.equal(projectItem(item, { fields: ['abstract'], abstractChars: 0 }).abstract.length, 250, '0 이면 자르지 않음');
+  assert.deepEqual(projectItem({ ...item, duplicates: ['NODE2'] }, { fields: ['tid'] }), { tid: 'NODE1', duplicates: ['NODE2'] });
+});
+
+test('structuredContent 는 format: "json" 일 때만', () => {
+  const data = { items: [{ tid: 'NODE1' }] };
+  const extra = { _meta: { cursor: '2' } };
+  assert.deepEqual(toolResult(parseOutputOptions({ format: 'json' }), '본문', data, extra), {
+    content: [{ type: "text", text: '{"items":[{"tid":"NODE1"}]}' }],
+    structuredContent: data,
+    ...extra
+  });
+  assert.deepEqual(toolResult(parseOutputOptions(), '본문', data, extra), { content: [{ type: "text", text: '본문' }], ...extra });
+});
+
+test('text 출력은 필드 선택 이전과 같은 형식', () => {
+  const fields = ['title', 'authors', 'journal', 'year', 'publisher', 'url', 'abstract'];
+  assert.equal(formatItem(item, 3, parseOutputOptions({ fields })), legacyFormatItem(item, 3));
+  assert.equal(formatItems([item, item], 10, parseOutputOptions({ fields })),
+    `${legacyFormatItem(item, 11)}\n${legacyFormatItem(item, 12)}`);
+  assert.equal(formatItem(item, 1),
+    '1. **전력 변환기 설계**\n   저자: 홍길동; 김철수 ;\n   학술지: 전자공학회논문지\n   출판년도: 2021\n   TID: NODE1\n',
+    '기본은 요약 필드');
+  assert.equal(formatItem({ ...item, duplicates: ['NODE2', 'NODE3'] }, 1, parseOutputOptions({ fields: ['tid'] })),
+    '1.\n   TID: NODE1\n   다른 판본: NODE2, NODE3\n');
+});
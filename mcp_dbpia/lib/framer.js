@@ -0,0 +1,73 @@
+// stdio JSON-RPC 프레이머
+// 줄바꿈으로 구분된 프레임을 Buffer 상태 그대로 모아 두었다가 완성된 프레임만
+// 한 번 디코딩·파싱한다 (readline 처럼 줄마다 중간 문자열을 만들지 않음).
+
+const NEWLINE = 0x0a;
+
+export class JsonRpcFramer {
+  constructor({ onMessage, onError, maxFrameBytes = 16 * 1024 * 1024 }) {
+    this.onMessage = onMessage;
+    this.onError = onError;
+    this.maxFrameBytes = maxFrameBytes;
+    this.chunks = [];
+    this.buffered = 0;
+    this.discarding = false;
+  }
+
+  push(chunk) {
+    let start = 0;
+    let newline = chunk.indexOf(NEWLINE);
+    while (newline !== -1) {
+      if (this.discarding) {
+        this.discarding = false;
+      } else if (this.chunks.length === 0) {
+        this.frame(chunk, start, newline);
+      } else {
+        this.chunks.push(chunk.subarray(start, newline));
+        const joined = Buffer.concat(this.chunks, this.buffered + newline - start);
+        this.chunks = [];
+        this.buffered = 0;
+        this.frame(joined, 0, joined.length);
+      }
+      start = newline + 1;
+      newline = chunk.indexOf(NEWLINE, start);
+    }
+
+    if (start < chunk.length && !this.discarding) {
+      this.chunks.push(start === 0 ? chunk : chunk.subarray(start));
+      this.buffered += chunk.length - start;
+      if (this.buffered > this.maxFrameBytes) {
+        // 너무 큰 프레임은 다음 줄바꿈까지 버림
+        this.chunks = [];
+        this.buffered = 0;
+        this.discarding = true;
+        this.onError(new Error(`Frame exceeds ${this.maxFrameBytes} bytes`));
+      }
+    }
+  }
+
+  end() {
+    if (this.chunks.length > 0) {
+      const joined = Buffer.concat(this.chunks, this.buffered);
+      this.chunks = [];
+      this.buffered = 0;
+      this.frame(joined, 0, joined.length);
+    }
+  }
+
+  frame(buffer, start, end) {
+    // 앞뒤 공백(\r 포함)만 있는 줄은 무시
+    while (start < end && buffer[start] <= 0x20) start++;
+    while (end > start && buffer[end - 1] <= 0x20) end--;
+    if (start === end) return;
+
+    let message;
+    try {
+      message = JSON.parse(buffer.toString('utf8', start, end));
+    } catch (error) {
+      this.onError(error);
+      return;
+    }
+    this.onMessage(message);
+  }
+}
@@ -0,0 +1,62 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { JsonRpcFramer } from './framer.js';
+
+function collect(options = {}) {
+  const messages = [];
+  const errors = [];
+  const framer = new JsonRpcFramer({
+    onMessage: message => messages.push(message),
+    onError: error => errors.push(error),
+    ...options
+  });
+  return { framer, messages, errors };
+}
+
+test('한 청크의 여러 프레임과 청크 경계에 걸친 프레임', () => {
+  const { framer, messages } = collect();
+  framer.push(Buffer.from('{"id":1}\n{"id":2}\n{"id"'));
+  framer.push(Buffer.from(':3,"params":{"q":"전'));
+  framer.push(Buffer.from('력"}}\n'));
+  assert.deepEqual(messages, [{ id: 1 }, { id: 2 }, { id: 3, params: { q: '전력' } }]);
+});
+
+test('UTF-8 문자가 청크 경계에서 잘려도 프레임 단위로 디코딩', () => {
+  const { framer, messages } = collect();
+  const bytes = Buffer.from('{"q":"한글"}\n');
+  framer.push(bytes.subarray(0, 7));
+  framer.push(bytes.subarray(7));
+  assert.deepEqual(messages, [{ q: '한글' }]);
+});
+
+test('CRLF·빈 줄은 무시하고 배치(배열)는 그대로 전달', () => {
+  const { framer, messages, errors } = collect();
+  framer.push(Buffer.from('\r\n  \n[{"id":1},{"id":2}]\r\n'));
+  assert.deepEqual(messages, [[{ id: 1 }, { id: 2 }]]);
+  assert.equal(errors.length, 0);
+});
+
+test('잘못된 JSON 은 오류로 알리고 다음 프레임은 계속 처리', () => {
+  const { framer, messages, errors } = collect();
+  framer.push(Buffer.from('{oops\n{"id":1}\n'));
+  assert.equal(errors.length, 1);
+  assert.deepEqual(messages, [{ id: 1 }]);
+});
+
+test('너무 큰 프레임은 다음 줄바꿈까지 버림', () => {
+  const { framer, messages, errors } = collect({ maxFrameBytes: 16 });
+  framer.push(Buffer.from('{"q":"'));
+  framer.push(Buffer.from('x'.repeat(20)));
+  framer.push(Buffer.from('more"}\n{"id":1}\n'));
+  assert.equal(errors.length, 1);
+  assert.match(errors[0].message, /exceeds 16 bytes/);
+  assert.deepEqual(messages, [{ id: 1 }]);
+});
+
+test('입력이 끝나면 줄바꿈 없는 마지막 프레임도 처리', () => {
+  const { framer, messages } = collect();
+  framer.push(Buffer.from('{"id":1}\n{"id":'));
+  framer.push(Buffer.from('2}'));
+  framer.end();
+  assert.deepEqual(messages, [{ id: 1 }, { id: 2 }]);
+});
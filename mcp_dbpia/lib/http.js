@@ -0,0 +1,135 @@
+// DBpia 아웃바운드 HTTP 클라이언트
+// keep-alive 에이전트로 소켓을 재사용하고, AbortController로 요청별 제한 시간을 강제한다.
+
+import { cancelledError, throwIfCancelled } from './cancel.js';
+
+// node-fetch 와 http/https(tls) 모듈은 첫 요청 때 불러온다.
+// initialize·tools/list 만 주고받는 세션은 이 비용을 치르지 않는다.
+let transport = null;
+
+export function loadTransport() {
+  transport ??= Promise.all([import('node-fetch'), import('http'), import('https')])
+    .then(([fetchModule, http, https]) => ({ fetch: fetchModule.default, http: http.default, https: https.default }));
+  return transport;
+}
+
+function countingAgent(Base, options, counters) {
+  const agent = new Base(options);
+  const createConnection = agent.createConnection;
+  agent.createConnection = function (...args) {
+    counters.socketsCreated++;
+    return createConnection.apply(this, args);
+  };
+  return agent;
+}
+
+export class HttpStatusError extends Error {
+  constructor(status, retryAfterMs = null) {
+    super(`DBpia 응답 오류 (HTTP ${status})`);
+    this.status = status;
+    this.retryAfterMs = retryAfterMs;
+  }
+}
+
+function parseRetryAfter(value) {
+  if (!value) return null;
+  const seconds = Number(value);
+  if (!Number.isNaN(seconds)) return seconds * 1000;
+  const date = Date.parse(value);
+  return Number.isNaN(date) ? null : Math.max(0, date - Date.now());
+}
+
+export class HttpClient {
+  constructor({ maxSockets = 16, maxFreeSockets = 8, keepAliveMs = 30000, timeoutMs = 10000 } = {}) {
+    this.timeoutMs = timeoutMs;
+    this.counters = {
+      requests: 0,
+      socketsCreated: 0,
+      timeouts: 0,
+      cancelled: 0,
+      errors: 0
+    };
+    this.agentOptions = {
+      keepAlive: true,
+      keepAliveMsecs: 1000,
+      maxSockets,
+      maxFreeSockets,
+      timeout: keepAliveMs
+    };
+    this.modules = null;
+    this.httpAgent = null;
+    this.httpsAgent = null;
+  }
+
+  agentFor(url) {
+    const { http, https } = this.modules;
+    if (url.protocol === 'https:') {
+      return this.httpsAgent ??= countingAgent(https.Agent, this.agentOptions, this.counters);
+    }
+    return this.httpAgent ??= countingAgent(http.Agent, this.agentOptions, this.counters);
+  }
+
+  // read(response)까지 포함한 전체 시간이 제한 시간 안에 끝나야 한다.
+  // timing 객체를 넘기면 응답 헤더까지(ttfbMs)와 본문 처리(bodyMs) 시간을 기록한다.
+  // signal 이 취소되면 연결과 본문 수신·파싱을 즉시 중단한다.
+  async get(url, read, { timeoutMs = this.timeoutMs, timing = {}, signal } = {}) {
+    this.modules ??= await loadTransport();
+    throwIfCancelled(signal);
+    const controller = new AbortController();
+    let timedOut = false;
+    const timer = setTimeout(() => {
+      timedOut = true;
+      controller.abort();
+    }, timeoutMs);
+    const onCancel = () => controller.abort();
+    signal?.addEventListener('abort', onCancel, { once: true });
+    this.counters.requests++;
+    const start = performance.now();
+    try {
+      const response = await this.modules.fetch(url, {
+        agent: (parsedUrl) => this.agentFor(parsedUrl),
+        signal: controller.signal
+      });
+      if (!response.ok) {
+        response.body?.resume?.();
+        throw new HttpStatusError(response.status, parseRetryAfter(response.headers.get('retry-after')));
+      }
+      const headersAt = performance.now();
+      timing.ttfbMs = headersAt - start;
+      const result = await read(response);
+      timing.bodyMs = performance.now() - headersAt;
+      return result;
+    } catch (error) {
+      if (controller.signal.aborted && !timedOut) {
+        this.counters.cancelled++;
+        throw cancelledError();
+      }
+      if (timedOut) {
+        this.counters.timeouts++;
+        const timeout = new Error(`DBpia 응답 시간 초과 (${timeoutMs}ms)`);
+        timeout.timeout = true;
+        throw timeout;
+      }
+      this.counters.errors++;
+      throw error;
+    } finally {
+      clearTimeout(timer);
+      signal?.removeEventListener('abort', onCancel);
+    }
+  }
+
+  stats() {
+    const { requests, socketsCreated } = this.counters;
+    const reused = Math.max(0, requests - socketsCreated);
+    return {
+      ...this.counters,
+      reusedRequests: reused,
+      reuseRate: requests ? reused / requests : 0
+    };
+  }
+
+  destroy() {
+    this.httpAgent?.destroy();
+    this.httpsAgent?.destroy();
+  }
+}
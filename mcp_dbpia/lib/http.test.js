@@ -0,0 +1,73 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import http from 'http';
+import { once } from 'events';
+import { HttpClient, HttpStatusError } from './http.js';
+
+// 경로별 응답: /ok 즉시, /slow 300ms 뒤, /busy 503 + Retry-After
+async function startServer(t) {
+  const server = http.createServer((request, response) => {
+    if (request.url === '/busy') {
+      response.writeHead(503, { 'Retry-After': '2' });
+      response.end('busy');
+    } else if (request.url === '/slow') {
+      const timer = setTimeout(() => response.end('late'), 300);
+      response.on('close', () => clearTimeout(timer));
+    } else {
+      response.end('ok');
+    }
+  });
+  server.listen(0, '127.0.0.1');
+  await once(server, 'listening');
+  t.after(() => server.close());
+  return `http://127.0.0.1:${server.address().port}`;
+}
+
+function client(t, options) {
+  const httpClient = new HttpClient(options);
+  t.after(() => httpClient.destroy());
+  return httpClient;
+}
+
+test('keep-alive: 순차 요청은 소켓 하나를 재사용', async t => {
+  const url = await startServer(t);
+  const httpClient = client(t);
+  for (let i = 0; i < 5; i++) {
+    assert.equal(await httpClient.get(`${url}/ok`, response => response.text()), 'ok');
+  }
+  const stats = httpClient.stats();
+  assert.equal(stats.requests, 5);
+  assert.equal(stats.socketsCreated, 1);
+  assert.equal(stats.reuseRate, 0.8);
+});
+
+test('응답이 제한 시간을 넘기면 timeout 오류', async t => {
+  const url = await startServer(t);
+  const httpClient = client(t, { timeoutMs: 50 });
+  const timing = {};
+  await assert.rejects(httpClient.get(`${url}/slow`, response => response.text(), { timing }), error => error.timeout === true);
+  assert.equal(httpClient.stats().timeouts, 1);
+  assert.equal(timing.bodyMs, undefined);
+});
+
+test('호출자 signal 로 취소하면 cancelled 오류', async t => {
+  const url = await startServer(t);
+  const httpClient = client(t);
+  const controller = new AbortController();
+  setTimeout(() => controller.abort(), 20);
+  await assert.rejects(httpClient.get(`${url}/slow`, response => response.text(), { signal: controller.signal }),
+    error => error.cancelled === true);
+  assert.equal(httpClient.stats().cancelled, 1);
+  assert.equal(httpClient.stats().timeouts, 0);
+});
+
+test('오류 상태는 HttpStatusError 로, Retry-After 는 ms 로', async t => {
+  const url = await startServer(t);
+  const httpClient = client(t);
+  await assert.rejects(httpClient.get(`${url}/busy`, response => response.text()), error => {
+    assert.ok(error instanceof HttpStatusError);
+    assert.equal(error.status, 503);
+    assert.equal(error.retryAfterMs, 2000);
+    return true;
+  });
+});
@@ -0,0 +1,278 @@
+// 로컬 역색인 (BM25)
+// 지금까지 가져온 DBpia 논문을 디스크에 보관하고 네트워크 없이 검색한다.
+// 한글·한자는 공백 단위 어절 안에서 문자 bigram으로, 영문·숫자는 단어 단위로 색인한다.
+// 저장: 새로 추가·변경된 논문만 <path>.log 에 JSON 줄로 덧붙이고, 로그가 색인의 절반(최소 1000건)을
+// 넘으면 전체 스냅샷(<path>)을 다시 써서 로그를 비운다.
+
+import { appendFile, mkdir, readFile, writeFile, rename, unlink } from 'fs/promises';
+import { dirname } from 'path';
+
+const K1 = 1.2;
+const B = 0.75;
+const TITLE_BOOST = 2;
+const SAVE_DELAY_MS = 2000;
+const COMPACT_MIN_RECORDS = 1000;
+const CJK = /[ᄀ-ᇿ㄰-㆏가-힯㐀-鿿]/;
+
+export function tokenize(text) {
+  const terms = [];
+  const words = String(text || '').normalize('NFC').toLowerCase().match(/[\p{L}\p{N}]+/gu) || [];
+  for (const word of words) {
+    if (!CJK.test(word)) {
+      terms.push(word);
+      continue;
+    }
+    const chars = [...word];
+    if (chars.length === 1) {
+      terms.push(word);
+      continue;
+    }
+    for (let i = 0; i < chars.length - 1; i++) {
+      terms.push(chars[i] + chars[i + 1]);
+    }
+  }
+  return terms;
+}
+
+function recordTerms(record) {
+  const title = tokenize(record.title);
+  const terms = [];
+  for (let i = 0; i < TITLE_BOOST; i++) {
+    terms.push(...title);
+  }
+  terms.push(...tokenize(record.authors), ...tokenize(record.abstract), ...tokenize(record.journal));
+  return terms;
+}
+
+export class LocalIndex {
+  constructor({ path = null } = {}) {
+    this.path = path;
+    this.records = new Map();
+    this.postings = new Map();
+    this.lengths = new Map();
+    this.totalLength = 0;
+    this.loading = null;
+    this.saveTimer = null;
+    // 아직 디스크에 쓰지 못한 변경 (tid → 레코드). 쓰기가 성공한 뒤에만 비운다.
+    this.pending = new Map();
+    this.logRecords = 0;
+    this.saving = Promise.resolve();
+    this.tempSeq = 0;
+    this.saveErrors = 0;
+  }
+
+  get logPath() {
+    return `${this.path}.log`;
+  }
+
+  // 스냅샷과 로그를 읽어 레코드 배열로 (로그는 뒤에 쓴 것이 우선)
+  async readStored(logPath = this.logPath) {
+    const records = new Map();
+    try {
+      for (const record of JSON.parse(await readFile(this.path, 'utf8')).records || []) {
+        records.set(record.tid, record);
+      }
+    } catch (error) {
+      // 스냅샷이 없거나 손상됨
+    }
+    let logRecords = 0;
+    try {
+      for (const line of (await readFile(logPath, 'utf8')).split('\n')) {
+        if (!line) continue;
+        try {
+          const record = JSON.parse(line);
+          records.set(record.tid, record);
+          logRecords++;
+        } catch (error) {
+          // 쓰다 만 마지막 줄
+        }
+      }
+    } catch (error) {
+      // 로그 없음
+    }
+    return { records: [...records.values()], logRecords };
+  }
+
+  load() {
+    this.loading ||= (async () => {
+      if (!this.path) return;
+      // 색인 파일이 없거나 손상된 경우 빈 색인으로 시작
+      const { records, logRecords } = await this.readStored();
+      for (const record of records) {
+        if (!this.records.has(record.tid)) {
+          this.insert(record);
+        }
+      }
+      this.logRecords = logRecords;
+    })();
+    return this.loading;
+  }
+
+  async add(items) {
+    await this.load();
+    for (const item of items) {
+      if (!item.tid) continue;
+      const existing = this.records.get(item.tid);
+      if (existing && JSON.stringify(existing) === JSON.stringify(item)) continue;
+      if (existing) {
+        this.remove(item.tid);
+      }
+      const record = { ...item };
+      this.insert(record);
+      this.pending.set(record.tid, record);
+    }
+    if (this.pending.size > 0) {
+      this.scheduleSave();
+    }
+  }
+
+  insert(record) {
+    const terms = recordTerms(record);
+    const counts = new Map();
+    for (const term of terms) {
+      counts.set(term, (counts.get(term) || 0) + 1);
+    }
+    for (const [term, tf] of counts) {
+      let posting = this.postings.get(term);
+      if (!posting) {
+        posting = new Map();
+        this.postings.set(term, posting);
+      }
+      posting.set(record.tid, tf);
+    }
+    this.records.set(record.tid, record);
+    this.lengths.set(record.tid, terms.length);
+    this.totalLength += terms.length;
+  }
+
+  remove(tid) {
+    const record = this.records.get(tid);
+    if (!record) return;
+    for (const term of new Set(recordTerms(record))) {
+      const posting = this.postings.get(term);
+      posting?.delete(tid);
+      if (posting && posting.size === 0) {
+        this.postings.delete(term);
+      }
+    }
+    this.totalLength -= this.lengths.get(tid) || 0;
+    this.lengths.delete(tid);
+    this.records.delete(tid);
+  }
+
+  async get(tid) {
+    await this.load();
+    return this.records.get(tid) || null;
+  }
+
+  async search(query, limit = 10) {
+    await this.load();
+    const n = this.records.size;
+    if (n === 0) return [];
+    const avgLength = this.totalLength / n;
+    const scores = new Map();
+
+    for (const term of new Set(tokenize(query))) {
+      const posting = this.postings.get(term);
+      if (!posting) continue;
+      const idf = Math.log(1 + (n - posting.size + 0.5) / (posting.size + 0.5));
+      for (const [tid, tf] of posting) {
+        const norm = K1 * (1 - B + B * this.lengths.get(tid) / avgLength);
+        scores.set(tid, (scores.get(tid) || 0) + idf * (tf * (K1 + 1)) / (tf + norm));
+      }
+    }
+
+    return [...scores]
+      .sort((a, b) => b[1] - a[1])
+      .slice(0, limit)
+      .map(([tid, score]) => ({ record: this.records.get(tid), score }));
+  }
+
+  scheduleSave() {
+    if (!this.path || this.saveTimer) return;
+    this.saveTimer = setTimeout(() => {
+      this.saveTimer = null;
+      // 실패한 변경은 pending 에 남아 있으므로 다음 주기에 다시 시도
+      this.save().catch(() => this.scheduleSave());
+    }, SAVE_DELAY_MS);
+    this.saveTimer.unref();
+  }
+
+  // 저장은 한 번에 하나씩 순서대로 (겹친 저장이 같은 파일을 동시에 쓰지 않도록)
+  save() {
+    const run = this.saving.then(() => this.write());
+    this.saving = run.catch(() => {});
+    return run;
+  }
+
+  async write() {
+    if (!this.path || this.pending.size === 0) return;
+    const batch = [...this.pending.values()];
+    try {
+      await mkdir(dirname(this.path), { recursive: true });
+      await appendFile(this.logPath, batch.map(record => JSON.stringify(record) + '\n').join(''));
+    } catch (error) {
+      this.saveErrors++;
+      throw error;
+    }
+    // 쓰는 동안 다시 바뀐 레코드는 남겨 둠
+    for (const record of batch) {
+      if (this.pending.get(record.tid) === record) {
+        this.pending.delete(record.tid);
+      }
+    }
+    this.logRecords += batch.length;
+    if (this.logRecords >= Math.max(COMPACT_MIN_RECORDS, this.records.size / 2)) {
+      await this.compact();
+    }
+  }
+
+  // 로그를 옮겨 둔 뒤(그 사이 다른 프로세스가 덧붙이는 줄은 새 로그로 감) 다른 프로세스가 저장한 논문까지
+  // 병합한 스냅샷을 임시 파일에 쓰고 원자적으로 교체
+  async compact() {
+    const seq = ++this.tempSeq;
+    const compacting = `${this.logPath}.${process.pid}.${seq}.compacting`;
+    try {
+      await rename(this.logPath, compacting);
+    } catch (error) {
+      return; // 다른 프로세스가 이미 정리함
+    }
+    const { records } = await this.readStored(compacting);
+    for (const record of records) {
+      if (!this.records.has(record.tid)) {
+        this.insert(record);
+      }
+    }
+    const temp = `${this.path}.${process.pid}.${seq}.tmp`;
+    try {
+      await writeFile(temp, JSON.stringify({ version: 1, records: [...this.records.values()] }));
+      await rename(temp, this.path);
+    } catch (error) {
+      // 스냅샷을 못 썼으면 옮겨 둔 로그를 되돌려 다음 압축 때 다시 반영
+      this.saveErrors++;
+      await appendFile(this.logPath, await readFile(compacting, 'utf8')).catch(() => {});
+      await unlink(compacting).catch(() => {});
+      throw error;
+    }
+    await unlink(compacting).catch(() => {});
+    this.logRecords = 0;
+  }
+
+  async flush() {
+    if (this.saveTimer) {
+      clearTimeout(this.saveTimer);
+      this.saveTimer = null;
+    }
+    await this.save();
+  }
+
+  stats() {
+    return {
+      documents: this.records.size,
+      terms: this.postings.size,
+      pendingWrites: this.pending.size,
+      logRecords: this.logRecords,
+      saveErrors: this.saveErrors
+    };
+  }
+}
@@ -0,0 +1,81 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { mkdtemp, readFile, readdir, rm, writeFile } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { LocalIndex, tokenize } from './local-index.js';
+
+async function tempDir(t) {
+  const dir = await mkdtemp(join(tmpdir(), 'dbpia-index-'));
+  t.after(() => rm(dir, { recursive: true, force: true }));
+  return dir;
+}
+
+function paper(tid, title, extra = {}) {
+  return { tid, title, authors: '', abstract: '', journal: '', ...extra };
+}
+
+test('한글은 어절 안 bigram, 영문·숫자는 단어 단위', () => {
+  assert.deepEqual(tokenize('전력관리 IC 5G'), ['전력', '력관', '관리', 'ic', '5g']);
+  assert.deepEqual(tokenize('칩'), ['칩']);
+});
+
+test('BM25: 제목에 나온 논문이 본문에만 나온 논문보다 앞', async () => {
+  const index = new LocalIndex();
+  await index.add([
+    paper('a', '무선 통신', { abstract: '전력 관리 기법' }),
+    paper('b', '전력 관리 회로'),
+    paper('c', '영상 처리')
+  ]);
+  const results = await index.search('전력 관리');
+  assert.deepEqual(results.map(result => result.record.tid), ['b', 'a']);
+});
+
+test('저장한 색인을 새 인스턴스에서 다시 읽음 (스냅샷 + 로그)', async t => {
+  const path = join(await tempDir(t), 'index.json');
+  const index = new LocalIndex({ path });
+  await index.add([paper('a', '전력 관리'), paper('b', '영상 처리')]);
+  await index.flush();
+  await index.add([paper('a', '전력 관리 개정판')]);
+  await index.flush();
+  assert.equal(index.stats().pendingWrites, 0);
+
+  const reloaded = new LocalIndex({ path });
+  assert.equal((await reloaded.get('a')).title, '전력 관리 개정판', '로그의 나중 줄이 우선');
+  assert.equal((await reloaded.get('b')).title, '영상 처리');
+});
+
+test('쓰기에 실패하면 변경을 버리지 않고 다음 저장에서 씀', async t => {
+  const dir = await tempDir(t);
+  await writeFile(join(dir, 'file'), '');
+  const index = new LocalIndex({ path: join(dir, 'file', 'index.json') });
+  await index.add([paper('a', '전력 관리')]);
+  await assert.rejects(index.flush());
+  assert.equal(index.stats().pendingWrites, 1);
+  assert.equal(index.stats().saveErrors, 1);
+
+  index.path = join(dir, 'index.json');
+  await index.flush();
+  assert.equal(index.stats().pendingWrites, 0);
+  assert.equal((await new LocalIndex({ path: index.path }).get('a')).title, '전력 관리');
+});
+
+test('겹친 저장은 순서대로 실행되고 로그가 커지면 스냅샷으로 압축', async t => {
+  const dir = await tempDir(t);
+  const path = join(dir, 'index.json');
+  const index = new LocalIndex({ path });
+  const saves = [];
+  for (let i = 0; i < 1200; i += 100) {
+    await index.add(Array.from({ length: 100 }, (_, j) => paper(`t${i + j}`, `논문 ${i + j}`)));
+    saves.push(index.save());
+  }
+  await Promise.all(saves);
+  await index.flush();
+
+  assert.equal(JSON.parse(await readFile(path, 'utf8')).records.length, 1200);
+  assert.ok(index.stats().logRecords < 1000);
+  assert.deepEqual((await readdir(dir)).filter(name => /\.(tmp|compacting)$/.test(name)), [], '임시 파일이 남지 않음');
+  const reloaded = new LocalIndex({ path });
+  await reloaded.load();
+  assert.equal(reloaded.stats().documents, 1200);
+});
@@ -0,0 +1,109 @@
+// 단계별 지연 시간 히스토그램
+// 로그 간격 버킷(ms)에 누적하고, 백분위수는 버킷 경계로 근사한다.
+
+import { mkdir, writeFile, rename } from 'fs/promises';
+import { dirname } from 'path';
+
+const BUCKETS = [1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 30000];
+
+export class Histogram {
+  constructor() {
+    this.counts = new Array(BUCKETS.length + 1).fill(0);
+    this.count = 0;
+    this.sum = 0;
+    this.max = 0;
+  }
+
+  observe(ms) {
+    let index = BUCKETS.findIndex(bound => ms <= bound);
+    if (index < 0) index = BUCKETS.length;
+    this.counts[index]++;
+    this.count++;
+    this.sum += ms;
+    this.max = Math.max(this.max, ms);
+  }
+
+  percentile(p) {
+    if (this.count === 0) return 0;
+    const rank = Math.ceil((p / 100) * this.count);
+    let seen = 0;
+    for (let i = 0; i < this.counts.length; i++) {
+      seen += this.counts[i];
+      if (seen >= rank) {
+        return Math.min(BUCKETS[i] ?? this.max, this.max);
+      }
+    }
+    return this.max;
+  }
+
+  summary() {
+    const round = value => Number(value.toFixed(2));
+    return {
+      count: this.count,
+      avg: round(this.count ? this.sum / this.count : 0),
+      p50: round(this.percentile(50)),
+      p95: round(this.percentile(95)),
+      p99: round(this.percentile(99)),
+      max: round(this.max),
+      buckets: Object.fromEntries(
+        this.counts.map((count, i) => [i < BUCKETS.length ? `le${BUCKETS[i]}` : 'inf', count])
+          .filter(([, count]) => count > 0))
+    };
+  }
+}
+
+export class Metrics {
+  constructor() {
+    this.startedAt = Date.now();
+    this.histograms = new Map();
+  }
+
+  observe(stage, ms) {
+    let histogram = this.histograms.get(stage);
+    if (!histogram) {
+      histogram = new Histogram();
+      this.histograms.set(stage, histogram);
+    }
+    histogram.observe(ms);
+  }
+
+  time(stage, fn) {
+    const start = performance.now();
+    try {
+      return fn();
+    } finally {
+      this.observe(stage, performance.now() - start);
+    }
+  }
+
+  snapshot() {
+    return {
+      uptimeSec: Math.round((Date.now() - this.startedAt) / 1000),
+      stages: Object.fromEntries([...this.histograms].map(([stage, histogram]) => [stage, histogram.summary()]))
+    };
+  }
+}
+
+// collect() 결과를 주기적으로 JSON 파일에 기록 (임시 파일 후 rename)
+export class MetricsFileWriter {
+  constructor({ path, intervalMs = 60000, collect }) {
+    this.path = path;
+    this.collect = collect;
+    this.tempSeq = 0;
+    this.timer = setInterval(() => this.write().catch(() => {}), intervalMs);
+    this.timer.unref();
+  }
+
+  async write() {
+    await mkdir(dirname(this.path), { recursive: true });
+    // 주기 기록과 종료 시 기록이 겹쳐도 서로의 임시 파일을 덮어쓰지 않도록 일련번호를 붙임
+    const temp = `${this.path}.${process.pid}.${++this.tempSeq}.tmp`;
+    await writeFile(temp, JSON.stringify({ pid: process.pid, writtenAt: new Date().toISOString(), ...this.collect() }, null, 2));
+    await rename(temp, this.path);
+  }
+
+  async close() {
+    clearInterval(this.timer);
+    await this.write().catch(() => {});
+  }
+}
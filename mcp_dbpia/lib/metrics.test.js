@@ -0,0 +1,50 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { mkdtemp, readFile, readdir, rm } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { Histogram, Metrics, MetricsFileWriter } from './metrics.js';
+
+test('히스토그램: 백분위수는 버킷 경계로 근사하고 최댓값을 넘지 않음', () => {
+  const histogram = new Histogram();
+  for (let i = 0; i < 90; i++) histogram.observe(3);
+  for (let i = 0; i < 9; i++) histogram.observe(40);
+  histogram.observe(70000);
+  const summary = histogram.summary();
+  assert.equal(summary.count, 100);
+  assert.equal(summary.p50, 5);
+  assert.equal(summary.p95, 50);
+  assert.equal(summary.p99, 50);
+  assert.equal(summary.max, 70000);
+  assert.deepEqual(summary.buckets, { le5: 90, le50: 9, inf: 1 });
+
+  const single = new Histogram();
+  single.observe(0.4);
+  assert.equal(single.percentile(50), 0.4, '버킷 경계보다 작은 최댓값');
+  assert.equal(new Histogram().percentile(99), 0);
+});
+
+test('단계별 시간 측정은 예외가 나도 기록', () => {
+  const metrics = new Metrics();
+  assert.equal(metrics.time('parse', () => 42), 42);
+  assert.throws(() => metrics.time('parse', () => {
+    throw new Error('bad');
+  }));
+  metrics.observe('upstream', 12);
+  const { stages } = metrics.snapshot();
+  assert.equal(stages.parse.count, 2);
+  assert.equal(stages.upstream.p50, 12, '버킷 경계(20)보다 작은 최댓값');
+});
+
+test('지표 파일은 겹쳐 써도 온전한 JSON 으로 남음', async t => {
+  const dir = await mkdtemp(join(tmpdir(), 'dbpia-metrics-'));
+  t.after(() => rm(dir, { recursive: true, force: true }));
+  const path = join(dir, 'metrics.json');
+  let n = 0;
+  const writer = new MetricsFileWriter({ path, intervalMs: 60000, collect: () => ({ n: ++n }) });
+  await Promise.all([writer.write(), writer.write(), writer.close()]);
+  const written = JSON.parse(await readFile(path, 'utf8'));
+  assert.equal(written.pid, process.pid);
+  assert.ok(written.n >= 1 && written.n <= 3);
+  assert.deepEqual((await readdir(dir)).filter(name => name.endsWith('.tmp')), []);
+});
@@ -0,0 +1,100 @@
+// DBpia 검색 응답 스트리밍 파서
+// 전체 XML을 버퍼링하거나 객체 트리를 만들지 않고, 응답 본문 스트림에서
+// document 요소의 필요한 필드만 뽑아내며 limit 개를 읽으면 파싱을 멈춘다 (남은 본문은 흘려보냄).
+// timing 객체를 넘기면 파서 안에서 보낸 시간(parseMs)을 기록한다.
+// sax 는 첫 파싱 때 불러온다 (본문 스트림은 data 리스너를 붙이기 전까지 흐르지 않음).
+
+let saxModule = null;
+
+export function loadSax() {
+  saxModule ??= import('sax').then(module => module.default);
+  return saxModule;
+}
+
+const FIELDS = new Set(['titl', 'auth', 'pbls', 'tid', 'abst', 'year', 'publ']);
+
+export async function parseDocuments(body, limit = Infinity, timing = {}) {
+  const sax = await loadSax();
+  return new Promise((resolve, reject) => {
+    const parser = sax.createStream(true, { trim: false, normalize: false });
+    const docs = [];
+    let doc = null;
+    let depth = 0;
+    let field = null;
+    let text = '';
+    let settled = false;
+    timing.parseMs = 0;
+
+    const finish = (error) => {
+      if (settled) return;
+      settled = true;
+      body.removeListener('data', onData);
+      if (error) {
+        body.destroy?.();
+        reject(error);
+        return;
+      }
+      // limit 에 도달해도 소켓을 끊지 않고 남은 본문을 버리며 읽어 keep-alive 풀로 돌려보냄
+      if (!body.readableEnded) {
+        body.resume?.();
+      }
+      resolve(docs);
+    };
+
+    parser.on('opentag', (node) => {
+      if (doc) {
+        depth++;
+      }
+      if (!doc && node.name === 'document') {
+        doc = {};
+        depth = 0;
+      } else if (doc && depth === 1 && !field && FIELDS.has(node.name)) {
+        field = node.name;
+        text = '';
+      }
+    });
+
+    const onText = (chunk) => {
+      if (field) {
+        text += chunk;
+      }
+    };
+    parser.on('text', onText);
+    parser.on('cdata', onText);
+
+    parser.on('closetag', (name) => {
+      if (!doc || settled) {
+        return;
+      }
+      if (depth > 0) {
+        if (field && depth === 1 && name === field) {
+          doc[field] = text.trim();
+          field = null;
+        }
+        depth--;
+        return;
+      }
+      docs.push(doc);
+      doc = null;
+      if (docs.length >= limit) {
+        finish();
+      }
+    });
+
+    const onData = (chunk) => {
+      const start = performance.now();
+      parser.write(chunk);
+      timing.parseMs += performance.now() - start;
+    };
+
+    parser.on('error', finish);
+    parser.on('end', () => finish());
+    body.on('error', finish);
+    body.on('data', onData);
+    body.on('end', () => {
+      if (!settled) {
+        parser.end();
+      }
+    });
+  });
+}
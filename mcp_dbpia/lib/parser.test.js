@@ -0,0 +1,66 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { once } from 'events';
+import { Readable } from 'stream';
+import { parseDocuments } from './parser.js';
+import { HttpClient } from './http.js';
+import { startStubServer } from '../bench/stub-server.js';
+
+const XML = `<?xml version="1.0" encoding="UTF-8"?><root><result><totalcount>3</totalcount></result>
+<response><documents>
+<document><titl><![CDATA[첫 번째 논문]]></titl><auth>홍길동</auth><tid>NODE1</tid><extra><titl>무시</titl></extra></document>
+<document><titl>두 번째 논문</titl><tid>NODE2</tid><year>2024</year></document>
+<document><titl>세 번째 논문</titl><tid>NODE3</tid></document>
+</documents></response></root>`;
+
+function chunked(text, size) {
+  const chunks = [];
+  for (let i = 0; i < text.length; i += size) chunks.push(Buffer.from(text.slice(i, i + size)));
+  return Readable.from(chunks);
+}
+
+test('document 의 1단계 필드만 추출', async () => {
+  const docs = await parseDocuments(chunked(XML, 7));
+  assert.deepEqual(docs, [
+    { titl: '첫 번째 논문', auth: '홍길동', tid: 'NODE1' },
+    { titl: '두 번째 논문', tid: 'NODE2', year: '2024' },
+    { titl: '세 번째 논문', tid: 'NODE3' }
+  ]);
+});
+
+test('limit 개를 읽으면 멈추고 남은 본문은 흘려보냄', async () => {
+  const body = chunked(XML, 16);
+  const docs = await parseDocuments(body, 1);
+  assert.equal(docs.length, 1);
+  if (!body.readableEnded) await once(body, 'end');
+  assert.equal(body.readableEnded, true);
+});
+
+test('본문 스트림 오류는 reject', async () => {
+  const body = new Readable({ read() {} });
+  const parsing = parseDocuments(body);
+  body.push('<root><document><titl>x');
+  setImmediate(() => body.destroy(new Error('socket hang up')));
+  await assert.rejects(parsing, /socket hang up/);
+});
+
+// limit 으로 중단해도 keep-alive 소켓이 풀로 돌아가야 함 (user-004 회귀)
+test('limit 도달 후에도 keep-alive 소켓 재사용', async () => {
+  const stub = await startStubServer({ port: 0, latencyMs: 0, docs: 200 });
+  const http = new HttpClient({ timeoutMs: 5000 });
+  try {
+    for (let i = 0; i < 10; i++) {
+      const docs = await http.get(`${stub.url}?searchall=test&pagecount=200`, response => parseDocuments(response.body, 5));
+      assert.equal(docs.length, 5);
+      // 남은 본문을 다 읽고 소켓이 풀로 돌아갈 시간
+      await new Promise(resolve => setTimeout(resolve, 20));
+    }
+    const stats = http.stats();
+    assert.equal(stats.requests, 10);
+    assert.equal(stats.socketsCreated, 1);
+    assert.equal(stats.reuseRate, 0.9);
+  } finally {
+    http.destroy();
+    await stub.close();
+  }
+});
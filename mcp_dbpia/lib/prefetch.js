@@ -0,0 +1,71 @@
+// 다음 페이지 추측 선반입 (speculative prefetch)
+// 페이지 N 을 돌려준 직후 N+1 을 백그라운드로 받아 캐시에 넣어 둔다.
+// 속도 제한 여유가 있을 때만 실행하며, 적중/낭비 횟수를 기록해 휴리스틱 조정에 쓴다.
+
+export class Prefetcher {
+  constructor({ enabled = false, maxInFlight = 2, windowMs = 10 * 60 * 1000, hasCapacity = () => true } = {}) {
+    this.enabled = enabled;
+    this.maxInFlight = maxInFlight;
+    this.windowMs = windowMs;
+    this.hasCapacity = hasCapacity;
+    this.inFlight = 0;
+    this.pending = new Map();
+    this.counters = {
+      issued: 0,
+      skipped: 0,
+      failed: 0,
+      hits: 0,
+      wasted: 0
+    };
+  }
+
+  // load() 는 캐시를 채우는 함수. 이미 선반입한 키는 다시 요청하지 않는다
+  schedule(key, load) {
+    if (!this.enabled || this.pending.has(key)) return;
+    this.sweep();
+    if (this.inFlight >= this.maxInFlight || !this.hasCapacity()) {
+      this.counters.skipped++;
+      return;
+    }
+    this.inFlight++;
+    this.counters.issued++;
+    this.pending.set(key, Date.now());
+    Promise.resolve()
+      .then(load)
+      .catch(() => {
+        this.counters.failed++;
+        this.pending.delete(key);
+      })
+      .finally(() => {
+        this.inFlight--;
+      });
+  }
+
+  // 실제 요청이 들어왔을 때 호출. 선반입한 키를 처음 쓰는 경우 적중으로 집계
+  consume(key) {
+    if (this.pending.delete(key)) {
+      this.counters.hits++;
+    }
+  }
+
+  // windowMs 안에 쓰이지 않은 선반입은 낭비로 집계하고 정리
+  sweep(now = Date.now()) {
+    for (const [key, issuedAt] of this.pending) {
+      if (now - issuedAt > this.windowMs) {
+        this.pending.delete(key);
+        this.counters.wasted++;
+      }
+    }
+  }
+
+  stats() {
+    this.sweep();
+    const { hits, wasted } = this.counters;
+    return {
+      ...this.counters,
+      enabled: this.enabled,
+      outstanding: this.pending.size,
+      hitRate: hits + wasted ? hits / (hits + wasted) : 0
+    };
+  }
+}
@@ -0,0 +1,55 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { Prefetcher } from './prefetch.js';
+
+const tick = () => new Promise(resolve => setImmediate(resolve));
+
+test('꺼져 있으면 선반입하지 않음', async () => {
+  const prefetcher = new Prefetcher();
+  let loads = 0;
+  prefetcher.schedule('p2', () => loads++);
+  await tick();
+  assert.equal(loads, 0);
+  assert.equal(prefetcher.stats().issued, 0);
+});
+
+test('같은 키는 한 번만, 동시 선반입 수와 여유 용량을 넘으면 건너뜀', async () => {
+  let capacity = true;
+  const prefetcher = new Prefetcher({ enabled: true, maxInFlight: 1, hasCapacity: () => capacity });
+  let release;
+  const loads = [];
+  prefetcher.schedule('p2', () => {
+    loads.push('p2');
+    return new Promise(resolve => (release = resolve));
+  });
+  prefetcher.schedule('p2', () => loads.push('again'));
+  prefetcher.schedule('p3', () => loads.push('p3'));
+  await tick();
+  release();
+  await tick();
+  capacity = false;
+  prefetcher.schedule('p4', () => loads.push('p4'));
+  await tick();
+  assert.deepEqual(loads, ['p2']);
+  assert.equal(prefetcher.stats().skipped, 2);
+});
+
+test('처음 쓰인 선반입은 적중, 시간 안에 쓰이지 않으면 낭비, 실패는 다시 시도 가능', async () => {
+  const prefetcher = new Prefetcher({ enabled: true, maxInFlight: 3, windowMs: 1000 });
+  prefetcher.schedule('p2', () => {});
+  prefetcher.schedule('p3', () => {});
+  prefetcher.schedule('p4', () => Promise.reject(new Error('503')));
+  await tick();
+  prefetcher.consume('p2');
+  prefetcher.consume('p2');
+  prefetcher.sweep(Date.now() + 2000);
+  const stats = prefetcher.stats();
+  assert.equal(stats.hits, 1);
+  assert.equal(stats.wasted, 1);
+  assert.equal(stats.failed, 1);
+  assert.equal(stats.hitRate, 0.5);
+  let retried = false;
+  prefetcher.schedule('p4', () => (retried = true));
+  await tick();
+  assert.equal(retried, true);
+});
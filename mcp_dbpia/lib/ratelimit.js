@@ -0,0 +1,243 @@
+// DBpia API 호출 보호 계층
+// - 토큰 버킷: API 할당량에 맞춰 초당 요청 수 제한 (429 수신 시 속도를 줄였다가 성공 시 점진 복구)
+// - 재시도: 429/5xx/네트워크 오류에 지터를 준 지수 백오프, 요청당 재시도 한도
+// - 서킷 브레이커: 연속 실패가 임계값을 넘으면 쿨다운 동안 즉시 실패
+
+import { HttpStatusError } from './http.js';
+import { cancelledError, sleep, throwIfCancelled } from './cancel.js';
+
+export class TokenBucket {
+  constructor({ ratePerSec = 10, burst = ratePerSec } = {}) {
+    this.maxRate = ratePerSec;
+    this.rate = ratePerSec;
+    this.burst = Math.max(1, burst);
+    this.tokens = this.burst;
+    this.lastRefill = Date.now();
+    this.waiters = [];
+    this.timer = null;
+    this.counters = { granted: 0, waited: 0, cancelled: 0 };
+  }
+
+  refill() {
+    const now = Date.now();
+    this.tokens = Math.min(this.burst, this.tokens + (now - this.lastRefill) / 1000 * this.rate);
+    this.lastRefill = now;
+  }
+
+  // signal 이 취소되면 대기열에서 빠지고 즉시 reject (토큰은 소비하지 않음)
+  take(signal) {
+    if (signal?.aborted) {
+      return Promise.reject(cancelledError());
+    }
+    this.refill();
+    if (this.waiters.length === 0 && this.tokens >= 1) {
+      this.tokens -= 1;
+      this.counters.granted++;
+      return Promise.resolve();
+    }
+    this.counters.waited++;
+    return new Promise((resolve, reject) => {
+      const grant = () => {
+        signal?.removeEventListener('abort', onAbort);
+        resolve();
+      };
+      const onAbort = () => {
+        const index = this.waiters.indexOf(grant);
+        if (index !== -1) {
+          this.waiters.splice(index, 1);
+        }
+        this.counters.cancelled++;
+        reject(cancelledError());
+      };
+      this.waiters.push(grant);
+      signal?.addEventListener('abort', onAbort, { once: true });
+      this.schedule();
+    });
+  }
+
+  schedule() {
+    if (this.timer || this.waiters.length === 0) return;
+    const delay = Math.max(0, (1 - this.tokens) / this.rate * 1000);
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      this.refill();
+      while (this.waiters.length > 0 && this.tokens >= 1) {
+        this.tokens -= 1;
+        this.counters.granted++;
+        this.waiters.shift()();
+      }
+      this.schedule();
+    }, delay);
+  }
+
+  // 429 응답 시 속도를 절반으로, 성공 시 5%씩 원래 속도까지 복구
+  penalize() {
+    this.refill();
+    this.rate = Math.max(this.maxRate / 16, this.rate / 2);
+  }
+
+  reward() {
+    if (this.rate < this.maxRate) {
+      this.refill();
+      this.rate = Math.min(this.maxRate, this.rate * 1.05);
+    }
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      rate: Number(this.rate.toFixed(2)),
+      maxRate: this.maxRate,
+      queued: this.waiters.length
+    };
+  }
+}
+
+export class CircuitBreaker {
+  constructor({ failureThreshold = 5, cooldownMs = 30000 } = {}) {
+    this.failureThreshold = failureThreshold;
+    this.cooldownMs = cooldownMs;
+    this.state = 'closed';
+    this.failures = 0;
+    this.openedAt = 0;
+    this.trialInFlight = false;
+    this.counters = { opened: 0, rejected: 0 };
+  }
+
+  // 호출 허용 여부. half-open 상태에서는 시험 요청 하나만 통과
+  allow() {
+    if (this.state === 'open' && Date.now() - this.openedAt >= this.cooldownMs) {
+      this.state = 'half-open';
+    }
+    if (this.state === 'closed') return true;
+    if (this.state === 'half-open' && !this.trialInFlight) {
+      this.trialInFlight = true;
+      return true;
+    }
+    this.counters.rejected++;
+    return false;
+  }
+
+  // 취소 등으로 결과를 판단할 수 없는 시도: 상태는 그대로 두고 시험 요청 자리만 반납
+  release() {
+    this.trialInFlight = false;
+  }
+
+  success() {
+    this.state = 'closed';
+    this.failures = 0;
+    this.trialInFlight = false;
+  }
+
+  failure() {
+    this.failures++;
+    this.trialInFlight = false;
+    if (this.state === 'half-open' || this.failures >= this.failureThreshold) {
+      if (this.state !== 'open') {
+        this.counters.opened++;
+      }
+      this.state = 'open';
+      this.openedAt = Date.now();
+    }
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      state: this.state,
+      consecutiveFailures: this.failures
+    };
+  }
+}
+
+// 429/5xx 응답과 시간 초과·연결 오류만 재시도 대상 (파싱 오류 등은 즉시 실패)
+function isRetryable(error) {
+  if (error instanceof HttpStatusError) {
+    return error.status === 429 || error.status >= 500;
+  }
+  return Boolean(error.timeout) || typeof error.code === 'string';
+}
+
+export class UpstreamGuard {
+  constructor({ ratePerSec = 10, burst, maxRetries = 3, baseDelayMs = 200, maxDelayMs = 5000,
+    failureThreshold = 5, cooldownMs = 30000 } = {}) {
+    this.bucket = new TokenBucket({ ratePerSec, burst });
+    this.breaker = new CircuitBreaker({ failureThreshold, cooldownMs });
+    this.maxRetries = maxRetries;
+    this.baseDelayMs = baseDelayMs;
+    this.maxDelayMs = maxDelayMs;
+    this.counters = { attempts: 0, retries: 0, throttled: 0, exhausted: 0 };
+  }
+
+  // 선반입 등 부가 요청용: 대기 없이 쓸 수 있는 토큰이 reserve 개를 넘고 서킷이 닫혀 있을 때만 true
+  hasSpareCapacity(reserve = 1) {
+    this.bucket.refill();
+    return this.breaker.state === 'closed' &&
+      this.bucket.waiters.length === 0 &&
+      this.bucket.tokens >= reserve + 1;
+  }
+
+  backoff(attempt, error) {
+    const exponential = Math.min(this.maxDelayMs, this.baseDelayMs * 2 ** attempt);
+    const jittered = Math.random() * exponential;
+    return Math.max(jittered, error.retryAfterMs ?? 0);
+  }
+
+  // 서킷 브레이커에는 호출 하나(재시도 포함)당 실패를 최대 한 번만 기록한다.
+  // 재시도 대상이 아닌 오류(400 등)는 업스트림 상태와 무관하므로 성공으로도 실패로도 세지 않음.
+  async run(fn, signal) {
+    let failureRecorded = false;
+    for (let attempt = 0; ; attempt++) {
+      throwIfCancelled(signal);
+      if (!this.breaker.allow()) {
+        throw new Error('DBpia API 일시 차단 중 (연속 실패로 서킷 브레이커 열림)');
+      }
+      try {
+        await this.bucket.take(signal);
+      } catch (error) {
+        this.breaker.release();
+        throw error;
+      }
+      this.counters.attempts++;
+      try {
+        const result = await fn();
+        this.breaker.success();
+        this.bucket.reward();
+        return result;
+      } catch (error) {
+        if (error.cancelled) {
+          this.breaker.release();
+          throw error;
+        }
+        if (!isRetryable(error)) {
+          this.breaker.release();
+          throw error;
+        }
+        if (failureRecorded) {
+          this.breaker.release();
+        } else {
+          this.breaker.failure();
+          failureRecorded = true;
+        }
+        if (error.status === 429) {
+          this.counters.throttled++;
+          this.bucket.penalize();
+        }
+        if (attempt >= this.maxRetries) {
+          this.counters.exhausted++;
+          throw error;
+        }
+        this.counters.retries++;
+        await sleep(this.backoff(attempt, error), signal);
+      }
+    }
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      bucket: this.bucket.stats(),
+      breaker: this.breaker.stats()
+    };
+  }
+}
@@ -0,0 +1,121 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { CircuitBreaker, TokenBucket, UpstreamGuard } from './ratelimit.js';
+import { HttpStatusError } from './http.js';
+
+const wait = ms => new Promise(resolve => setTimeout(resolve, ms));
+
+test('서킷 브레이커 상태 전이: closed → open → half-open → closed/open', async () => {
+  const breaker = new CircuitBreaker({ failureThreshold: 3, cooldownMs: 30 });
+  for (let i = 0; i < 2; i++) {
+    assert.equal(breaker.allow(), true);
+    breaker.failure();
+  }
+  assert.equal(breaker.state, 'closed');
+  breaker.allow();
+  breaker.failure();
+  assert.equal(breaker.state, 'open');
+  assert.equal(breaker.allow(), false);
+
+  await wait(40);
+  assert.equal(breaker.allow(), true, '쿨다운 뒤 시험 요청 하나 허용');
+  assert.equal(breaker.state, 'half-open');
+  assert.equal(breaker.allow(), false, '시험 요청은 하나만');
+  breaker.failure();
+  assert.equal(breaker.state, 'open', '시험 요청 실패 시 다시 열림');
+
+  await wait(40);
+  assert.equal(breaker.allow(), true);
+  breaker.success();
+  assert.equal(breaker.state, 'closed');
+  assert.equal(breaker.failures, 0);
+  assert.equal(breaker.stats().opened, 2);
+});
+
+test('release 는 상태를 바꾸지 않고 시험 요청 자리만 반납', async () => {
+  const breaker = new CircuitBreaker({ failureThreshold: 1, cooldownMs: 10 });
+  breaker.allow();
+  breaker.failure();
+  await wait(20);
+  assert.equal(breaker.allow(), true);
+  breaker.release();
+  assert.equal(breaker.state, 'half-open');
+  assert.equal(breaker.allow(), true);
+});
+
+test('토큰 버킷: 대기 중 취소되면 즉시 reject 하고 대기열에서 빠짐', async () => {
+  const bucket = new TokenBucket({ ratePerSec: 1, burst: 1 });
+  await bucket.take();
+  const controller = new AbortController();
+  const waiting = bucket.take(controller.signal);
+  assert.equal(bucket.waiters.length, 1);
+  const startedAt = Date.now();
+  setTimeout(() => controller.abort(), 10);
+  await assert.rejects(waiting, error => error.cancelled === true);
+  assert.ok(Date.now() - startedAt < 500, '토큰을 기다리지 않고 끝남');
+  assert.equal(bucket.waiters.length, 0);
+  assert.equal(bucket.stats().cancelled, 1);
+});
+
+function guard(options = {}) {
+  return new UpstreamGuard({ ratePerSec: 1000, maxRetries: 2, baseDelayMs: 1, maxDelayMs: 2,
+    failureThreshold: 3, cooldownMs: 1000, ...options });
+}
+
+test('재시도를 거쳐 성공하면 결과 반환', async () => {
+  const upstream = guard();
+  let calls = 0;
+  const result = await upstream.run(async () => {
+    if (++calls < 3) throw new HttpStatusError(503);
+    return 'ok';
+  });
+  assert.equal(result, 'ok');
+  assert.equal(upstream.counters.retries, 2);
+  assert.equal(upstream.breaker.state, 'closed');
+  assert.equal(upstream.breaker.failures, 0);
+});
+
+test('재시도를 모두 실패해도 브레이커 실패는 호출당 한 번', async () => {
+  const upstream = guard();
+  await assert.rejects(upstream.run(async () => {
+    throw new HttpStatusError(503);
+  }));
+  assert.equal(upstream.counters.attempts, 3);
+  assert.equal(upstream.breaker.failures, 1);
+  assert.equal(upstream.breaker.state, 'closed');
+});
+
+test('재시도 대상이 아닌 오류는 누적된 실패 횟수를 초기화하지 않음', async () => {
+  const upstream = guard({ maxRetries: 0 });
+  for (let i = 0; i < 2; i++) {
+    await assert.rejects(upstream.run(async () => {
+      throw new HttpStatusError(502);
+    }));
+  }
+  await assert.rejects(upstream.run(async () => {
+    throw new HttpStatusError(400);
+  }), error => error.status === 400);
+  assert.equal(upstream.counters.retries, 0);
+  assert.equal(upstream.breaker.failures, 2);
+  await assert.rejects(upstream.run(async () => {
+    throw new HttpStatusError(502);
+  }));
+  assert.equal(upstream.breaker.state, 'open');
+  await assert.rejects(upstream.run(async () => 'ok'), /서킷 브레이커/);
+});
+
+test('토큰 대기 중 취소되면 시도하지 않고 취소 오류', async () => {
+  const upstream = guard({ ratePerSec: 1, burst: 1 });
+  await upstream.run(async () => 'first');
+  const controller = new AbortController();
+  let called = false;
+  const running = upstream.run(async () => {
+    called = true;
+  }, controller.signal);
+  const startedAt = Date.now();
+  setTimeout(() => controller.abort(), 10);
+  await assert.rejects(running, error => error.cancelled === true);
+  assert.ok(Date.now() - startedAt < 500, '토큰을 기다리지 않고 끝남');
+  assert.equal(called, false);
+  assert.equal(upstream.breaker.state, 'closed');
+});
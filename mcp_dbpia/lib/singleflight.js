@@ -0,0 +1,74 @@
+// 동일 키에 대한 동시 요청 병합 (single-flight)
+// 같은 키로 진행 중인 작업이 있으면 새로 시작하지 않고 그 결과를 함께 기다린다.
+// 각 호출자는 자신의 signal 로 개별 취소할 수 있으며, 공유 작업은 기다리는
+// 호출자가 모두 취소했을 때만 중단된다 (fn 에 공유 signal 이 전달됨).
+
+import { cancelledError } from './cancel.js';
+
+export class SingleFlight {
+  constructor() {
+    this.inflight = new Map();
+    this.counters = {
+      leaders: 0,
+      shared: 0,
+      aborted: 0
+    };
+  }
+
+  run(key, fn, signal) {
+    let flight = this.inflight.get(key);
+    if (flight) {
+      this.counters.shared++;
+    } else {
+      this.counters.leaders++;
+      const controller = new AbortController();
+      flight = { controller, waiters: 0, promise: null };
+      flight.promise = Promise.resolve()
+        .then(() => fn(controller.signal))
+        .finally(() => {
+          if (this.inflight.get(key) === flight) {
+            this.inflight.delete(key);
+          }
+        });
+      this.inflight.set(key, flight);
+    }
+    return this.join(key, flight, signal);
+  }
+
+  join(key, flight, signal) {
+    flight.waiters++;
+    if (!signal) {
+      return flight.promise;
+    }
+    if (signal.aborted) {
+      this.leave(key, flight);
+      return Promise.reject(cancelledError());
+    }
+    return new Promise((resolve, reject) => {
+      const onAbort = () => {
+        this.leave(key, flight);
+        reject(cancelledError());
+      };
+      signal.addEventListener('abort', onAbort, { once: true });
+      flight.promise.then(resolve, reject).finally(() => signal.removeEventListener('abort', onAbort));
+    });
+  }
+
+  // 마지막 호출자가 떠나면 공유 작업을 중단하고, 새 호출자는 새 작업을 시작하도록 키를 비움
+  leave(key, flight) {
+    if (--flight.waiters > 0) return;
+    this.counters.aborted++;
+    flight.controller.abort();
+    flight.promise.catch(() => {});
+    if (this.inflight.get(key) === flight) {
+      this.inflight.delete(key);
+    }
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      inflight: this.inflight.size
+    };
+  }
+}
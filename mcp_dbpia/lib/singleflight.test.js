@@ -0,0 +1,67 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { SingleFlight } from './singleflight.js';
+import { sleep } from './cancel.js';
+
+test('같은 키의 동시 호출은 작업 하나를 공유하고, 끝나면 새로 시작', async () => {
+  const flights = new SingleFlight();
+  let calls = 0;
+  const fn = async () => {
+    calls++;
+    await sleep(20);
+    return calls;
+  };
+  const results = await Promise.all([flights.run('a', fn), flights.run('a', fn), flights.run('b', fn)]);
+  assert.deepEqual(results.slice(0, 2), [results[0], results[0]]);
+  assert.equal(calls, 2);
+  assert.deepEqual(flights.stats(), { leaders: 2, shared: 1, aborted: 0, inflight: 0 });
+  await flights.run('a', fn);
+  assert.equal(calls, 3);
+});
+
+test('실패도 기다리는 호출자 모두에게 전달', async () => {
+  const flights = new SingleFlight();
+  const fn = async () => {
+    await sleep(10);
+    throw new Error('boom');
+  };
+  const results = await Promise.allSettled([flights.run('a', fn), flights.run('a', fn)]);
+  assert.deepEqual(results.map(result => result.reason?.message), ['boom', 'boom']);
+});
+
+test('한 호출자가 취소해도 나머지가 기다리면 공유 작업은 계속', async () => {
+  const flights = new SingleFlight();
+  let sharedSignal = null;
+  const fn = async signal => {
+    sharedSignal = signal;
+    await sleep(30, signal);
+    return 'done';
+  };
+  const controller = new AbortController();
+  const first = flights.run('a', fn, controller.signal);
+  const second = flights.run('a', fn);
+  setTimeout(() => controller.abort(), 5);
+  await assert.rejects(first, error => error.cancelled === true);
+  assert.equal(await second, 'done');
+  assert.equal(sharedSignal.aborted, false);
+  assert.equal(flights.stats().aborted, 0);
+});
+
+test('모든 호출자가 취소하면 공유 작업을 중단하고 키를 비움', async () => {
+  const flights = new SingleFlight();
+  let sharedSignal = null;
+  const fn = async signal => {
+    sharedSignal = signal;
+    await sleep(1000, signal);
+  };
+  const controllers = [new AbortController(), new AbortController()];
+  const runs = controllers.map(controller => flights.run('a', fn, controller.signal));
+  await sleep(5);
+  controllers.forEach(controller => controller.abort());
+  const results = await Promise.allSettled(runs);
+  assert.ok(results.every(result => result.reason?.cancelled));
+  assert.equal(sharedSignal.aborted, true);
+  assert.equal(flights.stats().aborted, 1);
+  assert.equal(flights.stats().inflight, 0);
+  assert.equal(await flights.run('a', async () => 'fresh'), 'fresh');
+});
@@ -0,0 +1,161 @@
+// 백프레셔를 고려한 JSON-RPC 메시지 기록기
+// 같은 틱에 나온 메시지들을 재사용 버퍼(chunkBytes 단위)에 이어 붙여 한 번에 write 하고,
+// 스트림이 false 를 반환하면 drain 까지 다음 기록을 미룬다.
+// 아직 내보내지 못한 바이트가 maxQueuedBytes 를 넘으면 onPressure(true)로 알려
+// 새 요청 처리를 멈추게 하고, 절반 아래로 내려가면 onPressure(false)로 재개한다.
+
+export class ResponseWriter {
+  constructor({ stream, maxQueuedBytes = 8 * 1024 * 1024, chunkBytes = 64 * 1024, maxPooled = 8, onPressure = () => {} }) {
+    this.stream = stream;
+    this.maxQueuedBytes = Math.max(1, maxQueuedBytes);
+    this.chunkBytes = Math.max(1024, chunkBytes);
+    this.maxPooled = maxPooled;
+    this.onPressure = onPressure;
+    this.pool = [];
+    this.current = null;
+    this.offset = 0;
+    this.pending = [];
+    this.queuedBytes = 0;
+    this.waitingDrain = false;
+    this.scheduled = false;
+    this.paused = false;
+    this.closed = false;
+    this.readyWaiters = [];
+    this.flushWaiters = [];
+    this.counters = {
+      messages: 0,
+      bytes: 0,
+      writes: 0,
+      drains: 0,
+      pauses: 0,
+      peakQueuedBytes: 0
+    };
+
+    stream.on('error', () => this.close());
+  }
+
+  write(message) {
+    if (this.closed) return;
+    const text = JSON.stringify(message) + '\n';
+    const length = Buffer.byteLength(text);
+    this.counters.messages++;
+    this.counters.bytes += length;
+    this.queuedBytes += length;
+    this.counters.peakQueuedBytes = Math.max(this.counters.peakQueuedBytes, this.queuedBytes);
+
+    if (length > this.chunkBytes) {
+      // 청크보다 큰 메시지는 전용 버퍼로 (풀에 반납하지 않음)
+      this.seal();
+      this.pending.push({ buffer: Buffer.from(text), length, pooled: false });
+    } else {
+      if (this.current && this.offset + length > this.chunkBytes) {
+        this.seal();
+      }
+      if (!this.current) {
+        this.current = this.pool.pop() ?? Buffer.allocUnsafe(this.chunkBytes);
+      }
+      this.current.write(text, this.offset);
+      this.offset += length;
+    }
+
+    this.updatePressure();
+    this.schedule();
+  }
+
+  seal() {
+    if (this.current && this.offset > 0) {
+      this.pending.push({ buffer: this.current, length: this.offset, pooled: true });
+      this.current = null;
+      this.offset = 0;
+    }
+  }
+
+  schedule() {
+    if (this.scheduled) return;
+    this.scheduled = true;
+    setImmediate(() => {
+      this.scheduled = false;
+      this.seal();
+      this.pump();
+    });
+  }
+
+  pump() {
+    while (!this.waitingDrain && !this.closed && this.pending.length > 0) {
+      const chunk = this.pending.shift();
+      this.counters.writes++;
+      const ok = this.stream.write(chunk.buffer.subarray(0, chunk.length), () => this.release(chunk));
+      if (!ok) {
+        this.waitingDrain = true;
+        this.counters.drains++;
+        this.stream.once('drain', () => {
+          this.waitingDrain = false;
+          this.pump();
+        });
+      }
+    }
+  }
+
+  // 스트림이 청크를 내보낸 뒤 호출: 버퍼를 풀에 반납
+  release(chunk) {
+    this.queuedBytes -= chunk.length;
+    if (chunk.pooled && this.pool.length < this.maxPooled) {
+      this.pool.push(chunk.buffer);
+    }
+    this.updatePressure();
+    this.checkFlushed();
+  }
+
+  updatePressure() {
+    if (!this.paused && this.queuedBytes > this.maxQueuedBytes) {
+      this.paused = true;
+      this.counters.pauses++;
+      this.onPressure(true);
+    } else if (this.paused && (this.queuedBytes <= this.maxQueuedBytes / 2 || this.closed)) {
+      this.paused = false;
+      this.onPressure(false);
+      this.readyWaiters.splice(0).forEach(resolve => resolve());
+    }
+  }
+
+  checkFlushed() {
+    if (this.queuedBytes === 0 || this.closed) {
+      this.flushWaiters.splice(0).forEach(resolve => resolve());
+    }
+  }
+
+  // 기록 대기량이 상한 아래일 때 resolve (입력 읽기를 늦추는 데 사용)
+  ready() {
+    if (!this.paused) return Promise.resolve();
+    return new Promise(resolve => this.readyWaiters.push(resolve));
+  }
+
+  // 대기 중인 모든 메시지가 스트림으로 넘어갈 때까지 기다림
+  flush() {
+    return new Promise(resolve => {
+      this.flushWaiters.push(resolve);
+      this.checkFlushed();
+    });
+  }
+
+  // 상대가 스트림을 닫은 경우(EPIPE 등): 남은 출력은 버리고 대기자를 모두 깨움
+  close() {
+    if (this.closed) return;
+    this.closed = true;
+    this.pending = [];
+    this.current = null;
+    this.queuedBytes = 0;
+    this.updatePressure();
+    this.checkFlushed();
+  }
+
+  stats() {
+    return {
+      ...this.counters,
+      queuedBytes: this.queuedBytes,
+      maxQueuedBytes: this.maxQueuedBytes,
+      paused: this.paused,
+      pooledBuffers: this.pool.length
+    };
+  }
+}
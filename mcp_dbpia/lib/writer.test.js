@@ -0,0 +1,70 @@
+import test from 'node:test';
+import assert from 'node:assert/strict';
+import { Writable } from 'stream';
+import { ResponseWriter } from './writer.js';
+
+// 청크마다 delayMs 뒤에 완료되는 출력 스트림
+function sink({ delayMs = 0, highWaterMark = 16 * 1024 } = {}) {
+  const chunks = [];
+  const stream = new Writable({
+    highWaterMark,
+    write(chunk, encoding, callback) {
+      chunks.push(Buffer.from(chunk));
+      setTimeout(callback, delayMs);
+    }
+  });
+  return { stream, chunks, text: () => Buffer.concat(chunks).toString('utf8') };
+}
+
+test('같은 틱의 메시지는 한 번의 write 로 묶고 줄 단위 JSON 으로 기록', async () => {
+  const { stream, chunks, text } = sink();
+  const writer = new ResponseWriter({ stream });
+  writer.write({ id: 1 });
+  writer.write({ id: 2, result: '전력' });
+  await writer.flush();
+  assert.equal(chunks.length, 1);
+  assert.equal(text(), '{"id":1}\n{"id":2,"result":"전력"}\n');
+  assert.equal(writer.stats().writes, 1);
+});
+
+test('청크보다 큰 메시지는 전용 버퍼로 순서를 지켜 기록', async () => {
+  const { stream, text } = sink();
+  const writer = new ResponseWriter({ stream, chunkBytes: 1024 });
+  const big = 'x'.repeat(3000);
+  writer.write({ id: 1 });
+  writer.write({ id: 2, big });
+  writer.write({ id: 3 });
+  await writer.flush();
+  assert.deepEqual(text().trim().split('\n').map(line => JSON.parse(line).id), [1, 2, 3]);
+  assert.equal(writer.stats().writes, 3, '앞 청크, 큰 메시지, 뒤 청크');
+});
+
+test('대기 바이트가 상한을 넘으면 onPressure(true), 절반 아래로 내려가면 onPressure(false)', async () => {
+  const { stream, text } = sink({ delayMs: 5, highWaterMark: 1024 });
+  const events = [];
+  const writer = new ResponseWriter({ stream, maxQueuedBytes: 4096, chunkBytes: 1024, onPressure: paused => events.push(paused) });
+  for (let i = 0; i < 20; i++) {
+    writer.write({ id: i, data: 'y'.repeat(500) });
+  }
+  assert.equal(writer.stats().paused, true);
+  const ready = writer.ready();
+  await writer.flush();
+  await ready;
+  assert.deepEqual(events, [true, false]);
+  assert.equal(text().trim().split('\n').length, 20);
+  assert.equal(writer.stats().queuedBytes, 0);
+});
+
+test('스트림 오류 뒤에는 남은 출력을 버리고 대기자를 깨움', async () => {
+  const stream = new Writable({
+    write(chunk, encoding, callback) {
+      callback(new Error('EPIPE'));
+    }
+  });
+  const writer = new ResponseWriter({ stream, maxQueuedBytes: 10 });
+  writer.write({ id: 1, data: 'z'.repeat(100) });
+  await Promise.all([writer.flush(), writer.ready()]);
+  writer.write({ id: 2 });
+  assert.equal(writer.stats().queuedBytes, 0);
+  assert.equal(writer.stats().paused, false);
+});